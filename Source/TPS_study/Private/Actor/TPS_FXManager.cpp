@@ -0,0 +1,306 @@
+#include "Actor/TPS_FXManager.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+
+#include "Custom/TPSStats.h"
+#include "Library/ProjectileAssetStreamer.h"
+
+//===========================================================================
+// public function:
+//===========================================================================
+
+ATPS_FXManager::ATPS_FXManager()
+{
+	// only tick the frame an impact is queued
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+	PrimaryActorTick.TickGroup = TG_PostPhysics;
+}
+
+void ATPS_FXManager::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	FlushImpacts();
+	SetActorTickEnabled(false);
+}
+
+void ATPS_FXManager::QueueImpact(UParticleSystem* Template, USoundBase* Sound, const FTransform& ImpactTransform)
+{
+	if (Template == nullptr && Sound == nullptr) return;
+
+	const FVector location = ImpactTransform.GetLocation();
+	const float cellSize = FMath::Max(ImpactCellSize, 1.0f);
+
+	FImpactKey impactKey;
+	impactKey.Template = Template;
+	impactKey.Sound = Sound;
+	impactKey.Cell = FIntVector(FMath::FloorToInt(location.X / cellSize), FMath::FloorToInt(location.Y / cellSize), FMath::FloorToInt(location.Z / cellSize));
+
+	if (const int32* groupIndex = ImpactGroupIndices.Find(impactKey))
+	{
+		FImpactGroup& impactGroup = ImpactGroups[*groupIndex];
+		impactGroup.LocationSum += location;
+		impactGroup.Count++;
+
+		TotalMerged++;
+		INC_DWORD_STAT(STAT_TPS_FXImpactMerged);
+		return;
+	}
+
+	FImpactGroup impactGroup;
+	impactGroup.Template = Template;
+	impactGroup.Sound = Sound;
+	impactGroup.Transform = ImpactTransform;
+	impactGroup.LocationSum = location;
+	impactGroup.Count = 1;
+
+	ImpactGroupIndices.Add(impactKey, ImpactGroups.Add(impactGroup));
+
+	SetActorTickEnabled(true);
+}
+
+UParticleSystemComponent* ATPS_FXManager::SpawnEmitter(UParticleSystem* Template, const FTransform& SpawnTransform)
+{
+	if (Template == nullptr) return nullptr;
+
+	FFXPoolList& poolList = Pools.FindOrAdd(Template);
+
+	if (poolList.Live >= MaxLivePerTemplate || TotalLive >= MaxLiveTotal || !IsInViewDistance(SpawnTransform.GetLocation()))
+	{
+		poolList.Culled++;
+		TotalCulled++;
+		INC_DWORD_STAT(STAT_TPS_FXCulled);
+		return nullptr;
+	}
+
+	UParticleSystemComponent* emitter = nullptr;
+
+	while (poolList.FreeComponents.Num() > 0 && emitter == nullptr)
+	{
+		emitter = poolList.FreeComponents.Pop(false);
+		if (emitter && emitter->IsPendingKill())
+		{
+			poolList.Size--;
+			TotalSize--;
+			emitter = nullptr;
+		}
+	}
+
+	if (emitter)
+	{
+		poolList.Hit++;
+		TotalHit++;
+		INC_DWORD_STAT(STAT_TPS_FXPoolHit);
+	}
+	else
+	{
+		poolList.Miss++;
+		TotalMiss++;
+		INC_DWORD_STAT(STAT_TPS_FXPoolMiss);
+
+		emitter = CreatePooledEmitter(Template, poolList);
+		if (emitter == nullptr) return nullptr;
+	}
+
+	poolList.Live++;
+	TotalLive++;
+	SET_DWORD_STAT(STAT_TPS_FXLive, TotalLive);
+
+	emitter->SetWorldTransform(SpawnTransform, false, nullptr, ETeleportType::TeleportPhysics);
+	emitter->ActivateSystem(true);
+
+	return emitter;
+}
+
+void ATPS_FXManager::PrewarmEmitter(UParticleSystem* Template, const int32 InCount)
+{
+	if (Template == nullptr) return;
+
+	FFXPoolList& poolList = Pools.FindOrAdd(Template);
+
+	poolList.FreeComponents.Reserve(InCount);
+
+	while (poolList.Size < InCount)
+	{
+		UParticleSystemComponent* emitter = CreatePooledEmitter(Template, poolList);
+		if (emitter == nullptr) break;
+
+		poolList.FreeComponents.Push(emitter);
+	}
+}
+
+void ATPS_FXManager::PurgeEmitter(UParticleSystem* Template)
+{
+	FFXPoolList* poolList = Pools.Find(Template);
+	if (poolList == nullptr) return;
+
+	for (UParticleSystemComponent* emitter : poolList->FreeComponents)
+	{
+		if (emitter == nullptr || emitter->IsPendingKill()) continue;
+
+		// not counted as finished
+		emitter->OnSystemFinished.RemoveAll(this);
+		emitter->DestroyComponent();
+	}
+
+	// playing one still count as live until OnEmitterFinished
+	TotalSize -= poolList->Size;
+	SET_DWORD_STAT(STAT_TPS_FXPoolSize, TotalSize);
+
+	Pools.Remove(Template);
+}
+
+//=================
+// Getter (public):
+//=================
+
+int32 ATPS_FXManager::GetLiveCount() const { return TotalLive; }
+
+int32 ATPS_FXManager::GetPoolHitCount() const { return TotalHit; }
+
+int32 ATPS_FXManager::GetPoolMissCount() const { return TotalMiss; }
+
+int32 ATPS_FXManager::GetCulledCount() const { return TotalCulled; }
+
+int32 ATPS_FXManager::GetMergedImpactCount() const { return TotalMerged; }
+
+//===========================================================================
+// protected function:
+//===========================================================================
+
+void ATPS_FXManager::BeginPlay()
+{
+	Super::BeginPlay();
+
+	AssetsReleasedHandle = FProjectileAssetStreamer::OnAssetsReleased.AddUObject(this, &ATPS_FXManager::OnProjectileAssetsReleased);
+}
+
+void ATPS_FXManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FProjectileAssetStreamer::OnAssetsReleased.Remove(AssetsReleasedHandle);
+
+	UE_LOG(LogTemp, Log, TEXT("FX impact merged %i"), TotalMerged);
+
+	// so the budgets can be sized per map
+	for (const TPair<UParticleSystem*, FFXPoolList>& pool : Pools)
+	{
+		UE_LOG(LogTemp, Log, TEXT("FX pool %s: size %i, hit %i, miss %i, culled %i"),
+			*GetNameSafe(pool.Key), pool.Value.Size, pool.Value.Hit, pool.Value.Miss, pool.Value.Culled);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+//===========================================================================
+// private function:
+//===========================================================================
+
+void ATPS_FXManager::FlushImpacts()
+{
+	for (FImpactGroup& impactGroup : ImpactGroups)
+	{
+		// merged burst play at the middle of its impacts
+		impactGroup.Transform.SetLocation(impactGroup.LocationSum / impactGroup.Count);
+
+		if (UParticleSystemComponent* emitter = SpawnEmitter(impactGroup.Template, impactGroup.Transform))
+		{
+			emitter->SetFloatParameter(ImpactCountParameter, impactGroup.Count);
+		}
+
+		if (impactGroup.Sound)
+		{
+			UGameplayStatics::PlaySoundAtLocation(this, impactGroup.Sound, impactGroup.Transform.GetLocation());
+		}
+	}
+
+	ImpactGroups.Reset();
+	ImpactGroupIndices.Reset();
+}
+
+bool ATPS_FXManager::IsInViewDistance(const FVector& Location)
+{
+	if (CullDistance <= 0.0f) return true;
+
+	if (ViewLocationFrame != GFrameCounter)
+	{
+		ViewLocationFrame = GFrameCounter;
+		ViewLocations.Reset();
+
+		for (FConstPlayerControllerIterator it = GetWorld()->GetPlayerControllerIterator(); it; ++it)
+		{
+			const APlayerController* playerController = it->Get();
+			if (playerController && playerController->IsLocalController() && playerController->PlayerCameraManager)
+			{
+				ViewLocations.Add(playerController->PlayerCameraManager->GetCameraLocation());
+			}
+		}
+	}
+
+	// nobody to see it, or no camera yet: do not guess
+	if (ViewLocations.Num() == 0) return true;
+
+	const float cullDistanceSquared = CullDistance * CullDistance;
+
+	for (const FVector& viewLocation : ViewLocations)
+	{
+		if (FVector::DistSquared(viewLocation, Location) <= cullDistanceSquared) return true;
+	}
+	return false;
+}
+
+UParticleSystemComponent* ATPS_FXManager::CreatePooledEmitter(UParticleSystem* Template, FFXPoolList& PoolList)
+{
+	UParticleSystemComponent* emitter = NewObject<UParticleSystemComponent>(this, NAME_None, RF_Transient);
+	if (emitter == nullptr) return nullptr;
+
+	emitter->bAutoActivate = false;
+	emitter->bAutoDestroy = false;
+	emitter->SetTemplate(Template);
+	emitter->OnSystemFinished.AddDynamic(this, &ATPS_FXManager::OnEmitterFinished);
+	emitter->RegisterComponent();
+
+	PoolList.Size++;
+	TotalSize++;
+	SET_DWORD_STAT(STAT_TPS_FXPoolSize, TotalSize);
+
+	return emitter;
+}
+
+void ATPS_FXManager::OnProjectileAssetsReleased(const TSet<UObject*>& ReleasedObjects)
+{
+	TArray<UParticleSystem*> releasedTemplates;
+
+	for (const TPair<UParticleSystem*, FFXPoolList>& pool : Pools)
+	{
+		if (ReleasedObjects.Contains(pool.Key)) releasedTemplates.Add(pool.Key);
+	}
+
+	for (UParticleSystem* releasedTemplate : releasedTemplates)
+	{
+		PurgeEmitter(releasedTemplate);
+	}
+}
+
+void ATPS_FXManager::OnEmitterFinished(UParticleSystemComponent* FinishedComponent)
+{
+	TotalLive--;
+	SET_DWORD_STAT(STAT_TPS_FXLive, TotalLive);
+
+	FFXPoolList* poolList = Pools.Find(FinishedComponent->Template);
+
+	// its pool was purged while it played
+	if (poolList == nullptr)
+	{
+		FinishedComponent->OnSystemFinished.RemoveAll(this);
+		FinishedComponent->DestroyComponent();
+		return;
+	}
+
+	poolList->FreeComponents.Push(FinishedComponent);
+	poolList->Live--;
+}
@@ -1,23 +1,23 @@
 #include "TPS_Projectile.h"
+#include "TPS_FXManager.h"
+#include "TPS_ProjectilePool.h"
 #include "CustomCollisionChannel.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/SphereComponent.h"
 #include "ConstructorHelpers.h"
 #include "Engine/Engine.h"// delete later
 #include "Kismet/GameplayStatics.h"
-#include "GameFramework/ProjectileMovementComponent.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "ProjectileParticleDataAsset.h"
 #include "ProjectileSoundDataAsset.h"
-#include "TimerManager.h" // delete later
 #include "TPSFunctionLibrary.h"
+#include "TPSStats.h"
+#include "HitResponseTable.h"
+#include "WeaponSpecCache.h"
 
 ATPS_Projectile::ATPS_Projectile() 
 {
 	CollisionComp = CreateDefaultSubobject<USphereComponent>(TEXT("CollisionComp"));
-	MovementComp = CreateDefaultSubobject<UProjectileMovementComponent>(TEXT("MovementComp"));
-	ProjectileTrailParticle = CreateDefaultSubobject<UParticleSystemComponent>(TEXT("ProjectileTrailParticle"));
-	ProjectileTrailParticle->Activate(true);
 	CollisionComp->bHiddenInGame = false;
 	CollisionComp->InitSphereRadius(5.0f);
 	CollisionComp->AlwaysLoadOnClient = true;
@@ -44,124 +44,146 @@ ATPS_Projectile::ATPS_Projectile()
 	}*/
 
 	RootComponent = CollisionComp;
-	ProjectileTrailParticle->SetupAttachment(CollisionComp);
 
-	UE_LOG(LogTemp, Log, TEXT("Event construct!"));
+	// the sweep is done by ATPS_ProjectileSimulation with the setting above
+	SetActorEnableCollision(false);
 }
 
-void ATPS_Projectile::SetUpProjectile(FProjectile MyProjectile, APawn* InInstigator) 
+void ATPS_Projectile::ActivateProjectile(const FProjectileSpec& MyProjectile, APawn* InInstigator, const FTransform& SpawnTransform)
 {
-	ProjectileParticleObject = MyProjectile.ProjectileParticle;
-	ProjectileSoundObject = MyProjectile.ProjectileSound;
-	ProjectileData = MyProjectile.ProjectileData;
-	
-	if (ProjectileData.SpeedxGravityxScale.Num() > 0) 
-	{
-		MovementComp->InitialSpeed = ProjectileData.SpeedxGravityxScale[0];
-	}
-	else
+	ProjectileParticleObject = MyProjectile.ParticleObject;
+	ProjectileSoundObject = MyProjectile.SoundObject;
+	HitResponses = MyProjectile.HitResponses;
+	Instigator = InInstigator;
+	bIsProjectileActive = true;
+
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::TeleportPhysics);
+	SetActorHiddenInGame(false);
+
+	TrailTemplate = nullptr;
+
+	if (ProjectileParticleObject) 
 	{
-		FProjectileData defaultProjectile;
+		const TArray<UParticleSystem*>& trailParticle = ProjectileParticleObject->ProjectileParticle.TrailParticle;
 
-		MovementComp->InitialSpeed = defaultProjectile.SpeedxGravityxScale[0];
+		if (trailParticle.Num() > 0)
+			TrailTemplate = trailParticle[0];
 	}
 
-	MovementComp->ProjectileGravityScale = (ProjectileData.SpeedxGravityxScale.Num() > 2) ? ProjectileData.SpeedxGravityxScale[2] : 0.0f;
+	// the simulation hide it next frame if the projectile is not significant
+	bIsTrailVisible = false;
+	SetTrailVisible(true);
+}
+
+void ATPS_Projectile::DeactivateProjectile()
+{
+	bIsProjectileActive = false;
+	bIsTrailVisible = false;
+
+	ReleaseTrail();
+
+	// a pooled projectile does not hold on to the asset of its last shot, its bundle can be released
+	ProjectileParticleObject = nullptr;
+	ProjectileSoundObject = nullptr;
+	HitResponses.Reset();
+	TrailTemplate = nullptr;
 
-	UE_LOG(LogTemp, Log, TEXT("Event setup!"));
+	SetActorHiddenInGame(true);
 }
 
-void ATPS_Projectile::BeginPlay() 
+bool ATPS_Projectile::IsProjectileActive() const { return bIsProjectileActive; }
+
+void ATPS_Projectile::SetTrailVisible(const bool bInVisible)
 {
-	Super::BeginPlay();
+	if (bIsTrailVisible == bInVisible) return;
 
-	if (ProjectileParticleObject) 
+	bIsTrailVisible = bInVisible;
+
+	if (!bInVisible)
 	{
-		float particleScale = (ProjectileData.SpeedxGravityxScale.Num() >= 3) ? ProjectileData.SpeedxGravityxScale[2] : 1.0f;
+		ReleaseTrail();
+		return;
+	}
 
-		SetActorScale3D(FVector(particleScale));
+	// a culled trail (FX budget or distance) is asked again only after the projectile was hidden
+	if (TrailTemplate == nullptr || FXManager == nullptr || TrailComponent) return;
 
-		TArray<UParticleSystem*> muzzleParticle = ProjectileParticleObject->ProjectileParticle.MuzzleParticle;
+	TrailComponent = FXManager->SpawnEmitter(TrailTemplate, GetActorTransform());
 
-		if (muzzleParticle.Num() >= 0 && muzzleParticle[0] != nullptr)
-			UGameplayStatics::SpawnEmitterAtLocation(
-				this, 
-				muzzleParticle[0],
-				GetActorLocation(), 
-				GetActorRotation(), 
-				GetActorScale(), 
-				true, 
-				EPSCPoolMethod::None
-			);
+	if (TrailComponent)
+	{
+		TrailComponent->AttachToComponent(CollisionComp, FAttachmentTransformRules::KeepWorldTransform);
+		INC_DWORD_STAT(STAT_TPS_ProjectileTrail);
+	}
+}
 
-		TArray<UParticleSystem*> trailParticle = ProjectileParticleObject->ProjectileParticle.TrailParticle;
+void ATPS_Projectile::ReleaseTrail()
+{
+	if (TrailComponent == nullptr) return;
 
-		if (trailParticle.Num() > 0 && trailParticle[0] != nullptr)
-			ProjectileTrailParticle->SetTemplate(
-				trailParticle[0]
-			);
-	}
+	// left where it is to fade out, the FX manager take it back when it is finished
+	TrailComponent->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+	TrailComponent->Deactivate();
+	TrailComponent = nullptr;
 
-	if (ProjectileSoundObject) {
-		USoundBase* muzzleSound = ProjectileSoundObject->ProjectileSound.MuzzleSound;
+	DEC_DWORD_STAT(STAT_TPS_ProjectileTrail);
+}
+
+void ATPS_Projectile::SetOwningPool(ATPS_ProjectilePool* InPool) { OwningPool = InPool; }
+
+void ATPS_Projectile::SpawnMuzzleEffect(ATPS_FXManager* FXManager, const UProjectileParticleDataAsset* InParticleObject, const FTransform& MuzzleTransform)
+{
+	if (FXManager == nullptr) return;
+
+	if (InParticleObject)
+	{
+		const TArray<UParticleSystem*>& muzzleParticle = InParticleObject->ProjectileParticle.MuzzleParticle;
 
-		if (muzzleSound)
-			UGameplayStatics::PlaySoundAtLocation(
-				this,
-				muzzleSound,
-				GetActorLocation()
-			);
+		if (muzzleParticle.Num() > 0 && muzzleParticle[0] != nullptr)
+			FXManager->SpawnEmitter(muzzleParticle[0], MuzzleTransform);
 	}
+}
+
+void ATPS_Projectile::SpawnHitEffect(ATPS_FXManager* FXManager, const FHitResponse& InResponse, const FTransform& HitTransform)
+{
+	if (FXManager == nullptr) return;
+
+	// pellets landing together this frame share one burst and one sound
+	FXManager->QueueImpact(InResponse.Particle.Get(), InResponse.Sound.Get(), HitTransform);
+}
+
+void ATPS_Projectile::BeginPlay() 
+{
+	Super::BeginPlay();
 
 	CollisionComp->OnComponentBeginOverlap.AddDynamic(this, &ATPS_Projectile::ShowOverlapObjectData);
 	CollisionComp->OnComponentHit.AddDynamic(this, &ATPS_Projectile::ShowHitObjectData);
 
-	UE_LOG(LogTemp, Log, TEXT("Event BEGINPLAY!"));
-	UKismetSystemLibrary::PrintString(this, FString("Projectile Begin Play"), true, false, FLinearColor::Red, 5.0f);
+	// pooled, so this run once per actor, not once per shot
+	FXManager = UTPSFunctionLibrary::GetWorldManager<ATPS_FXManager>(this);
 }
 
 void ATPS_Projectile::DestroySelf() 
 { 
-	GetWorld()->DestroyActor(this); 
+	if (OwningPool)
+	{
+		OwningPool->ReleaseProjectile(this);
+		return;
+	}
 
-	UE_LOG(LogTemp, Log, TEXT("Event DESTROY!"));
+	GetWorld()->DestroyActor(this); 
 }
 
 void ATPS_Projectile::NotifyHit(UPrimitiveComponent * MyComp, AActor * Other, UPrimitiveComponent * OtherComp, bool bSelfMoved, FVector HitLocation, FVector HitNormal, FVector NormalImpulse, const FHitResult & Hit) 
 {
-	TArray<UParticleSystem*> hitParticle = ProjectileParticleObject->ProjectileParticle.HitParticle;
-
-	if (ProjectileParticleObject)
-	{
-		if (hitParticle.Num() >= 0 && hitParticle[0] != nullptr)
-			UGameplayStatics::SpawnEmitterAtLocation(
-				this,
-				hitParticle[0],
-				GetActorLocation(),
-				GetActorRotation(),
-				GetActorScale(),
-				true,
-				EPSCPoolMethod::None
-			);
-
-		if (ProjectileTrailParticle != nullptr)
-			ProjectileTrailParticle->DestroyComponent();
-	}
+	if (!bIsProjectileActive) return;
 
-	if (ProjectileSoundObject)
+	if (HitResponses)
 	{
-		TArray<USoundBase*> hitSound = ProjectileSoundObject->ProjectileSound.HitAndTrailSound;
-
-		if (hitSound.Num() > 0 && hitSound[0] != nullptr)
-			UGameplayStatics::PlaySoundAtLocation(
-				this,
-				hitSound[0],
-				GetActorLocation()
-			);
+		SpawnHitEffect(FXManager, HitResponses->Resolve(Hit), FTransform(GetActorRotation(), HitLocation, GetActorScale()));
 	}
 
-	GetWorldTimerManager().ClearTimer(TimerDestroy);
-	GetWorldTimerManager().SetTimer(TimerDestroy, this, &ATPS_Projectile::DestroySelf, 3.0f);
+	DestroySelf();
 }
 
 void ATPS_Projectile::ShowOverlapObjectData(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult & SweepResult)
@@ -0,0 +1,151 @@
+#include "Actor/TPS_ProjectilePool.h"
+#include "Engine/World.h"
+
+#include "Actor/TPS_Projectile.h"
+#include "Custom/TPSStats.h"
+#include "Library/WeaponSpecCache.h"
+
+//===========================================================================
+// public function:
+//===========================================================================
+
+ATPS_ProjectilePool::ATPS_ProjectilePool()
+{
+	PrimaryActorTick.bCanEverTick = false;
+}
+
+ATPS_Projectile* ATPS_ProjectilePool::AcquireProjectile(const FProjectileSpec& MyProjectile, APawn* InInstigator, const FTransform& SpawnTransform)
+{
+	UClass* projectileClass = MyProjectile.ProjectileClass;
+	FProjectilePoolList& poolList = GetPoolList(projectileClass);
+
+	ATPS_Projectile* projectile = nullptr;
+
+	while (poolList.FreeProjectiles.Num() > 0 && projectile == nullptr)
+	{
+		projectile = poolList.FreeProjectiles.Pop(false);
+		if (projectile && projectile->IsPendingKill())
+		{
+			poolList.Size--;
+			TotalSize--;
+			SET_DWORD_STAT(STAT_TPS_ProjectilePoolSize, TotalSize);
+			projectile = nullptr;
+		}
+	}
+
+	if (projectile == nullptr)
+	{
+		poolList.Miss++;
+		TotalMiss++;
+		INC_DWORD_STAT(STAT_TPS_ProjectilePoolMiss);
+
+		projectile = SpawnPooledProjectile(projectileClass, poolList);
+		if (projectile == nullptr) return nullptr;
+	}
+
+	poolList.InUse++;
+	poolList.HighWaterMark = FMath::Max(poolList.HighWaterMark, poolList.InUse);
+	TotalInUse++;
+	TotalHighWaterMark = FMath::Max(TotalHighWaterMark, TotalInUse);
+	SET_DWORD_STAT(STAT_TPS_ProjectilePoolInUse, TotalInUse);
+	SET_DWORD_STAT(STAT_TPS_ProjectilePoolHighWater, TotalHighWaterMark);
+
+	projectile->ActivateProjectile(MyProjectile, InInstigator, SpawnTransform);
+
+	return projectile;
+}
+
+void ATPS_ProjectilePool::ReleaseProjectile(ATPS_Projectile* MyProjectile)
+{
+	if (MyProjectile == nullptr || !MyProjectile->IsProjectileActive()) return;
+
+	MyProjectile->DeactivateProjectile();
+
+	FProjectilePoolList& poolList = GetPoolList(MyProjectile->GetClass());
+	poolList.FreeProjectiles.Push(MyProjectile);
+	poolList.InUse--;
+	TotalInUse--;
+	SET_DWORD_STAT(STAT_TPS_ProjectilePoolInUse, TotalInUse);
+}
+
+void ATPS_ProjectilePool::InitProjectileClass(TSubclassOf<ATPS_Projectile> ProjectileClass)
+{
+	GetPoolList(ProjectileClass ? *ProjectileClass : ATPS_Projectile::StaticClass());
+}
+
+void ATPS_ProjectilePool::PrewarmProjectile(TSubclassOf<ATPS_Projectile> ProjectileClass, const int32 InCount)
+{
+	UClass* projectileClass = ProjectileClass ? *ProjectileClass : ATPS_Projectile::StaticClass();
+	FProjectilePoolList& poolList = GetPoolList(projectileClass);
+
+	poolList.FreeProjectiles.Reserve(InCount);
+
+	while (poolList.Size < InCount)
+	{
+		ATPS_Projectile* projectile = SpawnPooledProjectile(projectileClass, poolList);
+		if (projectile == nullptr) break;
+
+		poolList.FreeProjectiles.Push(projectile);
+	}
+}
+
+//=================
+// Getter (public):
+//=================
+
+int32 ATPS_ProjectilePool::GetPoolSize() const { return TotalSize; }
+
+int32 ATPS_ProjectilePool::GetHighWaterMark() const { return TotalHighWaterMark; }
+
+int32 ATPS_ProjectilePool::GetMissCount() const { return TotalMiss; }
+
+//===========================================================================
+// protected function:
+//===========================================================================
+
+void ATPS_ProjectilePool::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// so PrewarmCount can be sized per map
+	for (const TPair<UClass*, FProjectilePoolList>& pool : Pools)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Projectile pool %s: size %i, high water mark %i, miss %i"),
+			*GetNameSafe(pool.Key), pool.Value.Size, pool.Value.HighWaterMark, pool.Value.Miss);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+//===========================================================================
+// private function:
+//===========================================================================
+
+FProjectilePoolList& ATPS_ProjectilePool::GetPoolList(UClass* ProjectileClass)
+{
+	FProjectilePoolList* poolList = Pools.Find(ProjectileClass);
+	if (poolList) return *poolList;
+
+	FProjectilePoolList& newPoolList = Pools.Add(ProjectileClass);
+	PrewarmProjectile(ProjectileClass, PrewarmCount);
+
+	return newPoolList;
+}
+
+ATPS_Projectile* ATPS_ProjectilePool::SpawnPooledProjectile(UClass* ProjectileClass, FProjectilePoolList& PoolList)
+{
+	FActorSpawnParameters spawnParams;
+	spawnParams.Owner = this;
+	spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	spawnParams.ObjectFlags |= RF_Transient;
+
+	ATPS_Projectile* projectile = GetWorld()->SpawnActor<ATPS_Projectile>(ProjectileClass, FTransform::Identity, spawnParams);
+	if (projectile == nullptr) return nullptr;
+
+	projectile->SetOwningPool(this);
+	projectile->DeactivateProjectile();
+
+	PoolList.Size++;
+	TotalSize++;
+	SET_DWORD_STAT(STAT_TPS_ProjectilePoolSize, TotalSize);
+
+	return projectile;
+}
@@ -0,0 +1,832 @@
+#include "Actor/TPS_ProjectileSimulation.h"
+#include "Components/SphereComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "Particles/ParticleSystemComponent.h"
+
+#include "Actor/TPS_FXManager.h"
+#include "Actor/TPS_Projectile.h"
+#include "Actor/TPS_ProjectilePool.h"
+#include "Custom/TPSStats.h"
+#include "DataAsset/ProjectileParticleDataAsset.h"
+#include "Library/HitResponseTable.h"
+#include "Library/ProjectileIntegrator.h"
+#include "Library/TPSFunctionLibrary.h"
+#include "Library/WeaponSpecCache.h"
+
+static TAutoConsoleVariable<int32> CVarProjectileVectorIntegrate(
+	TEXT("TPS.Projectile.VectorIntegrate"),
+	1,
+	TEXT("1 = integrate projectiles 4 at a time with VectorRegister, 0 = scalar reference path"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarProjectileCollisionMode(
+	TEXT("TPS.Projectile.CollisionMode"),
+	-1,
+	TEXT("-1 = use the CollisionMode of each projectile class, 0 = force sync sweep, 1 = force async sweep"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarProjectileHitscan(
+	TEXT("TPS.Projectile.Hitscan"),
+	-1,
+	TEXT("-1 = use the HitscanSpeed of each weapon, 0 = force simulated, 1 = force hitscan (resolved at fire time)"),
+	ECVF_Default);
+
+/** LifeTime of a projectile retired by a hit this frame, so it is not also counted as expired */
+static const float HitLifeTime = -MAX_flt;
+
+//===========================================================================
+// FProjectileSimulationData:
+//===========================================================================
+
+void FProjectileSimulationData::Reserve(const int32 InNum)
+{
+	PositionX.Reserve(InNum);
+	PositionY.Reserve(InNum);
+	PositionZ.Reserve(InNum);
+	VelocityX.Reserve(InNum);
+	VelocityY.Reserve(InNum);
+	VelocityZ.Reserve(InNum);
+	GravityZ.Reserve(InNum);
+	LifeTime.Reserve(InNum);
+	Radius.Reserve(InNum);
+	ParticleScale.Reserve(InNum);
+	SweepStartX.Reserve(InNum);
+	SweepStartY.Reserve(InNum);
+	SweepStartZ.Reserve(InNum);
+	AsyncSweepStartX.Reserve(InNum);
+	AsyncSweepStartY.Reserve(InNum);
+	AsyncSweepStartZ.Reserve(InNum);
+	Significance.Reserve(InNum);
+	UpdatePhase.Reserve(InNum);
+	ClassIndex.Reserve(InNum);
+	TraceHandles.Reserve(InNum);
+	Instigators.Reserve(InNum);
+	ParticleObjects.Reserve(InNum);
+	SoundObjects.Reserve(InNum);
+	HitResponses.Reserve(InNum);
+	Visuals.Reserve(InNum);
+}
+
+int32 FProjectileSimulationData::Add()
+{
+	PositionX.AddUninitialized();
+	PositionY.AddUninitialized();
+	PositionZ.AddUninitialized();
+	VelocityX.AddUninitialized();
+	VelocityY.AddUninitialized();
+	VelocityZ.AddUninitialized();
+	GravityZ.AddUninitialized();
+	LifeTime.AddUninitialized();
+	Radius.AddUninitialized();
+	ParticleScale.AddUninitialized();
+	SweepStartX.AddUninitialized();
+	SweepStartY.AddUninitialized();
+	SweepStartZ.AddUninitialized();
+	AsyncSweepStartX.AddUninitialized();
+	AsyncSweepStartY.AddUninitialized();
+	AsyncSweepStartZ.AddUninitialized();
+	Significance.Add((uint8)EProjectileSignificance::Near);
+	UpdatePhase.AddUninitialized();
+	ClassIndex.AddUninitialized();
+	TraceHandles.AddDefaulted();
+	Instigators.AddDefaulted();
+	ParticleObjects.Add(nullptr);
+	SoundObjects.Add(nullptr);
+	HitResponses.Add(nullptr);
+
+	return Visuals.Add(nullptr);
+}
+
+void FProjectileSimulationData::RemoveAtSwap(const int32 Index)
+{
+	PositionX.RemoveAtSwap(Index, 1, false);
+	PositionY.RemoveAtSwap(Index, 1, false);
+	PositionZ.RemoveAtSwap(Index, 1, false);
+	VelocityX.RemoveAtSwap(Index, 1, false);
+	VelocityY.RemoveAtSwap(Index, 1, false);
+	VelocityZ.RemoveAtSwap(Index, 1, false);
+	GravityZ.RemoveAtSwap(Index, 1, false);
+	LifeTime.RemoveAtSwap(Index, 1, false);
+	Radius.RemoveAtSwap(Index, 1, false);
+	ParticleScale.RemoveAtSwap(Index, 1, false);
+	SweepStartX.RemoveAtSwap(Index, 1, false);
+	SweepStartY.RemoveAtSwap(Index, 1, false);
+	SweepStartZ.RemoveAtSwap(Index, 1, false);
+	AsyncSweepStartX.RemoveAtSwap(Index, 1, false);
+	AsyncSweepStartY.RemoveAtSwap(Index, 1, false);
+	AsyncSweepStartZ.RemoveAtSwap(Index, 1, false);
+	Significance.RemoveAtSwap(Index, 1, false);
+	UpdatePhase.RemoveAtSwap(Index, 1, false);
+	ClassIndex.RemoveAtSwap(Index, 1, false);
+	TraceHandles.RemoveAtSwap(Index, 1, false);
+	Instigators.RemoveAtSwap(Index, 1, false);
+	ParticleObjects.RemoveAtSwap(Index, 1, false);
+	SoundObjects.RemoveAtSwap(Index, 1, false);
+	HitResponses.RemoveAtSwap(Index, 1, false);
+	Visuals.RemoveAtSwap(Index, 1, false);
+}
+
+void FProjectileSimulationData::Empty()
+{
+	PositionX.Empty();
+	PositionY.Empty();
+	PositionZ.Empty();
+	VelocityX.Empty();
+	VelocityY.Empty();
+	VelocityZ.Empty();
+	GravityZ.Empty();
+	LifeTime.Empty();
+	Radius.Empty();
+	ParticleScale.Empty();
+	SweepStartX.Empty();
+	SweepStartY.Empty();
+	SweepStartZ.Empty();
+	AsyncSweepStartX.Empty();
+	AsyncSweepStartY.Empty();
+	AsyncSweepStartZ.Empty();
+	Significance.Empty();
+	UpdatePhase.Empty();
+	ClassIndex.Empty();
+	TraceHandles.Empty();
+	Instigators.Empty();
+	ParticleObjects.Empty();
+	SoundObjects.Empty();
+	HitResponses.Empty();
+	Visuals.Empty();
+}
+
+//===========================================================================
+// public function:
+//===========================================================================
+
+ATPS_ProjectileSimulation::ATPS_ProjectileSimulation()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = true;
+	PrimaryActorTick.TickGroup = TG_PrePhysics;
+}
+
+void ATPS_ProjectileSimulation::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	SCOPE_CYCLE_COUNTER(STAT_TPS_ProjectileSimulation);
+
+	if (ScheduledImpacts.Num() > 0)
+	{
+		PlayScheduledImpacts();
+	}
+
+	if (Projectiles.Num() > 0)
+	{
+		IntegrateProjectiles(DeltaSeconds);
+		UpdateSignificance();
+		SweepProjectiles();
+		RetireProjectiles();
+		UpdateVisuals();
+	}
+
+	// a soak run should see this flatten out, not keep growing
+	PeakProjectileCount = FMath::Max(PeakProjectileCount, Projectiles.Num());
+
+	SET_DWORD_STAT(STAT_TPS_ProjectileLiveCount, Projectiles.Num());
+	SET_DWORD_STAT(STAT_TPS_ProjectilePeakCount, PeakProjectileCount);
+}
+
+void ATPS_ProjectileSimulation::AddProjectile(const FProjectileSpec& MyProjectile, APawn* InInstigator, const FTransform& SpawnTransform, const float TimeOffset)
+{
+	check(MyProjectile.ProjectileClass && MyProjectile.HitResponses.IsValid());
+
+	const float particleScale = MyProjectile.ParticleScale;
+	const int32 classIndex = GetClassInfoIndex(MyProjectile.ProjectileClass);
+
+	const FVector location = SpawnTransform.GetLocation();
+	FVector velocity = SpawnTransform.GetRotation().GetForwardVector() * MyProjectile.Speed;
+	const float gravityZ = GetWorld()->GetGravityZ() * MyProjectile.GravityScale;
+
+	float lifeTime = (MyProjectile.MaxLifeTime > 0.0f) ? MyProjectile.MaxLifeTime : MaxLifeTime;
+
+	// range become life time, so both are retired by the same countdown
+	if (MyProjectile.MaxRange > 0.0f && MyProjectile.Speed > 0.0f)
+	{
+		lifeTime = FMath::Min(lifeTime, MyProjectile.MaxRange / MyProjectile.Speed);
+	}
+
+	if (IsHitscan(MyProjectile))
+	{
+		AddHitscanProjectile(MyProjectile, InInstigator, SpawnTransform, TimeOffset, lifeTime);
+		return;
+	}
+
+	const int32 i = Projectiles.Add();
+
+	if (TimeOffset > 0.0f)
+	{
+		// same step as FProjectileIntegrator
+		const FVector offsetLocation = location + velocity * TimeOffset + FVector(0.0f, 0.0f, gravityZ * 0.5f * TimeOffset * TimeOffset);
+		velocity.Z += gravityZ * TimeOffset;
+
+		Projectiles.PositionX[i] = offsetLocation.X;
+		Projectiles.PositionY[i] = offsetLocation.Y;
+		Projectiles.PositionZ[i] = offsetLocation.Z;
+	}
+	else
+	{
+		Projectiles.PositionX[i] = location.X;
+		Projectiles.PositionY[i] = location.Y;
+		Projectiles.PositionZ[i] = location.Z;
+	}
+
+	// the segment from the muzzle is still swept, even if the round start further along
+	Projectiles.SweepStartX[i] = location.X;
+	Projectiles.SweepStartY[i] = location.Y;
+	Projectiles.SweepStartZ[i] = location.Z;
+	Projectiles.Significance[i] = (uint8)EProjectileSignificance::Near;
+	Projectiles.UpdatePhase[i] = NextUpdatePhase++;
+
+	Projectiles.VelocityX[i] = velocity.X;
+	Projectiles.VelocityY[i] = velocity.Y;
+	Projectiles.VelocityZ[i] = velocity.Z;
+	Projectiles.GravityZ[i] = gravityZ;
+	Projectiles.LifeTime[i] = lifeTime - TimeOffset;
+	Projectiles.Radius[i] = ClassInfos[classIndex].Radius * particleScale;
+	Projectiles.ParticleScale[i] = particleScale;
+	Projectiles.ClassIndex[i] = classIndex;
+	Projectiles.Instigators[i] = InInstigator;
+	Projectiles.ParticleObjects[i] = MyProjectile.ParticleObject;
+	Projectiles.SoundObjects[i] = MyProjectile.SoundObject;
+	Projectiles.HitResponses[i] = MyProjectile.HitResponses;
+
+	const FTransform muzzleTransform(SpawnTransform.GetRotation(), location, FVector(particleScale));
+
+	ATPS_Projectile::SpawnMuzzleEffect(FXManager, MyProjectile.ParticleObject, muzzleTransform);
+
+	// only projectile with a trail need an actor to be seen
+	if (MyProjectile.bHasTrail && ProjectilePool)
+	{
+		Projectiles.Visuals[i] = ProjectilePool->AcquireProjectile(MyProjectile, InInstigator, muzzleTransform);
+	}
+}
+
+void ATPS_ProjectileSimulation::PrewarmProjectile(const FProjectileSpec& MyProjectile)
+{
+	GetClassInfoIndex(MyProjectile.ProjectileClass);
+
+	// only a simulated projectile with a trail take an actor from the pool
+	if (MyProjectile.bHasTrail && !IsHitscan(MyProjectile) && ProjectilePool)
+	{
+		ProjectilePool->InitProjectileClass(MyProjectile.ProjectileClass);
+	}
+
+	if (FXManager == nullptr || MyProjectile.ParticleObject == nullptr) return;
+
+	const FProjectileParticle& particle = MyProjectile.ParticleObject->ProjectileParticle;
+
+	if (particle.MuzzleParticle.Num() > 0) FXManager->PrewarmEmitter(particle.MuzzleParticle[0], PrewarmEmitterCount);
+	if (MyProjectile.bHasTrail) FXManager->PrewarmEmitter(particle.TrailParticle[0], PrewarmEmitterCount);
+
+	for (UParticleSystem* hitParticle : particle.HitParticle)
+	{
+		FXManager->PrewarmEmitter(hitParticle, PrewarmEmitterCount);
+	}
+}
+
+void ATPS_ProjectileSimulation::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	ATPS_ProjectileSimulation* This = CastChecked<ATPS_ProjectileSimulation>(InThis);
+
+	Collector.AddReferencedObjects(This->Projectiles.ParticleObjects, This);
+	Collector.AddReferencedObjects(This->Projectiles.SoundObjects, This);
+
+	for (FScheduledImpact& impact : This->ScheduledImpacts)
+	{
+		Collector.AddReferencedObject(impact.ParticleObject, This);
+		Collector.AddReferencedObject(impact.SoundObject, This);
+	}
+
+	Super::AddReferencedObjects(InThis, Collector);
+}
+
+//=================
+// Getter (public):
+//=================
+
+int32 ATPS_ProjectileSimulation::GetProjectileCount() const { return Projectiles.Num(); }
+
+int32 ATPS_ProjectileSimulation::GetPeakProjectileCount() const { return PeakProjectileCount; }
+
+int32 ATPS_ProjectileSimulation::GetHitCount() const { return TotalHit; }
+
+int32 ATPS_ProjectileSimulation::GetHitscanHitCount() const { return TotalHitscanHit; }
+
+int32 ATPS_ProjectileSimulation::GetExpiredCount() const { return TotalExpired; }
+
+int32 ATPS_ProjectileSimulation::GetOutOfWorldCount() const { return TotalOutOfWorld; }
+
+int32 ATPS_ProjectileSimulation::GetSignificanceCount(const EProjectileSignificance InSignificance) const
+{
+	if (InSignificance >= EProjectileSignificance::Max) return 0;
+	return SignificanceCounts[(int32)InSignificance];
+}
+
+//===========================================================================
+// protected function:
+//===========================================================================
+
+void ATPS_ProjectileSimulation::BeginPlay()
+{
+	Super::BeginPlay();
+
+	ProjectilePool = UTPSFunctionLibrary::GetWorldManager<ATPS_ProjectilePool>(this);
+	FXManager = UTPSFunctionLibrary::GetWorldManager<ATPS_FXManager>(this);
+
+	const AWorldSettings* worldSettings = GetWorld()->GetWorldSettings();
+	KillZ = (worldSettings && worldSettings->bEnableWorldBoundsChecks) ? worldSettings->KillZ : -HALF_WORLD_MAX;
+
+	Projectiles.Reserve(InitialCapacity);
+	RetiredIndices.Reserve(InitialCapacity);
+	Hits.Reserve(InitialCapacity / 8);
+	ScheduledImpacts.Reserve(InitialCapacity / 8);
+}
+
+void ATPS_ProjectileSimulation::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// so the life time and range can be sized per map
+	UE_LOG(LogTemp, Log, TEXT("Projectile simulation: peak %i, hit %i, hitscan hit %i, expired %i, out of world %i"), PeakProjectileCount, TotalHit, TotalHitscanHit, TotalExpired, TotalOutOfWorld);
+
+	// the impact will not be played, their tracer would loop forever
+	for (FScheduledImpact& impact : ScheduledImpacts)
+	{
+		if (impact.Tracer.IsValid()) impact.Tracer->Deactivate();
+	}
+
+	Projectiles.Empty();
+	ScheduledImpacts.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+//===========================================================================
+// private function:
+//===========================================================================
+
+int32 ATPS_ProjectileSimulation::GetClassInfoIndex(UClass* ProjectileClass)
+{
+	if (const int32* foundIndex = ClassInfoIndices.Find(ProjectileClass)) return *foundIndex;
+
+	const ATPS_Projectile* projectileDefault = GetDefault<ATPS_Projectile>(ProjectileClass);
+	const USphereComponent* collisionComp = projectileDefault->GetCollisionComp();
+
+	FProjectileClassInfo classInfo;
+	classInfo.Radius = collisionComp->GetUnscaledSphereRadius();
+	classInfo.bTraceComplex = collisionComp->bTraceComplexOnMove;
+	classInfo.bAsyncSweep = projectileDefault->GetCollisionMode() == EProjectileCollisionMode::Async;
+	classInfo.ObjectType = collisionComp->GetCollisionObjectType();
+	classInfo.ResponseParams = FCollisionResponseParams(collisionComp->GetCollisionResponseToChannels());
+
+	const int32 newIndex = ClassInfos.Add(classInfo);
+	ClassInfoIndices.Add(ProjectileClass, newIndex);
+
+	return newIndex;
+}
+
+bool ATPS_ProjectileSimulation::IsHitscan(const FProjectileSpec& MyProjectile) const
+{
+	const int32 forcedHitscan = CVarProjectileHitscan.GetValueOnGameThread();
+	return (forcedHitscan < 0) ? MyProjectile.bIsHitscan : forcedHitscan == 1;
+}
+
+void ATPS_ProjectileSimulation::AddHitscanProjectile(const FProjectileSpec& MyProjectile, APawn* InInstigator, const FTransform& SpawnTransform, const float TimeOffset, const float LifeTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPS_ProjectileHitscan);
+	INC_DWORD_STAT(STAT_TPS_ProjectileHitscanCount);
+
+	check(MyProjectile.ProjectileClass && MyProjectile.HitResponses.IsValid());
+
+	UWorld* world = GetWorld();
+	const float particleScale = MyProjectile.ParticleScale;
+	const FProjectileClassInfo& classInfo = ClassInfos[GetClassInfoIndex(MyProjectile.ProjectileClass)];
+
+	const FVector location = SpawnTransform.GetLocation();
+	const FVector velocity = SpawnTransform.GetRotation().GetForwardVector() * MyProjectile.Speed;
+	const float gravityZ = world->GetGravityZ() * MyProjectile.GravityScale;
+
+	FCollisionQueryParams queryParams(SCENE_QUERY_STAT(ProjectileHitscan), classInfo.bTraceComplex, InInstigator);
+	queryParams.bReturnPhysicalMaterial = true;
+	const FCollisionShape sphere = FCollisionShape::MakeSphere(classInfo.Radius * particleScale);
+
+	// each chord stay close to the arc, so the hit match the simulated projectile
+	const int32 segmentCount = (gravityZ == 0.0f) ? 1 : FMath::Max(HitscanSegmentCount, 1);
+	const float segmentTime = LifeTime / segmentCount;
+
+	FScheduledImpact impact;
+	impact.bHit = false;
+	impact.HitResponses = MyProjectile.HitResponses;
+	impact.ParticleObject = MyProjectile.ParticleObject;
+	impact.SoundObject = MyProjectile.SoundObject;
+
+	FVector segmentStart = location;
+	float arrivalTime = LifeTime;
+
+	for (int32 segment = 1; segment <= segmentCount; segment++)
+	{
+		// same step as FProjectileIntegrator
+		const float time = segmentTime * segment;
+		const FVector segmentEnd = location + velocity * time + FVector(0.0f, 0.0f, gravityZ * 0.5f * time * time);
+
+		INC_DWORD_STAT(STAT_TPS_ProjectileSyncSweep);
+
+		if (world->SweepSingleByChannel(impact.Hit, segmentStart, segmentEnd, FQuat::Identity, classInfo.ObjectType, sphere, queryParams, classInfo.ResponseParams))
+		{
+			impact.bHit = true;
+			arrivalTime = segmentTime * (segment - 1 + impact.Hit.Time);
+			segmentStart = impact.Hit.Location;
+			break;
+		}
+
+		segmentStart = segmentEnd;
+	}
+
+	const FVector impactVelocity(velocity.X, velocity.Y, velocity.Z + gravityZ * arrivalTime);
+	impact.Transform = FTransform(impactVelocity.Rotation(), segmentStart, FVector(particleScale));
+
+	// a round fired late is already TimeOffset along its path
+	impact.ArrivalTime = world->GetTimeSeconds() + FMath::Max(arrivalTime - TimeOffset, 0.0f);
+
+	const FTransform muzzleTransform(SpawnTransform.GetRotation(), location, FVector(particleScale));
+
+	ATPS_Projectile::SpawnMuzzleEffect(FXManager, MyProjectile.ParticleObject, muzzleTransform);
+
+	// pooled emitter instead of a projectile actor, the particle draw the line to the impact
+	if (MyProjectile.bHasTrail && FXManager)
+	{
+		UParticleSystem* tracerParticle = MyProjectile.ParticleObject->ProjectileParticle.TrailParticle[0];
+
+		if (UParticleSystemComponent* tracer = FXManager->SpawnEmitter(tracerParticle, muzzleTransform))
+		{
+			tracer->SetVectorParameter(TracerEndParameter, segmentStart);
+			impact.Tracer = tracer;
+		}
+	}
+
+	ScheduledImpacts.Add(impact);
+}
+
+void ATPS_ProjectileSimulation::PlayScheduledImpacts()
+{
+	const float now = GetWorld()->GetTimeSeconds();
+
+	for (int32 i = ScheduledImpacts.Num() - 1; i >= 0; i--)
+	{
+		const FScheduledImpact& impact = ScheduledImpacts[i];
+		if (impact.ArrivalTime > now) continue;
+
+		const FHitResponse& response = impact.bHit ? impact.HitResponses->Resolve(impact.Hit) : impact.HitResponses->NoHitResponse;
+		ATPS_Projectile::SpawnHitEffect(FXManager, response, impact.Transform);
+
+		if (impact.bHit) TotalHitscanHit++;
+
+		// the trail loop, like ATPS_Projectile::ReleaseTrail it is finished by deactivating it
+		if (impact.Tracer.IsValid()) impact.Tracer->Deactivate();
+
+		ScheduledImpacts.RemoveAtSwap(i, 1, false);
+	}
+}
+
+void ATPS_ProjectileSimulation::IntegrateProjectiles(const float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPS_ProjectileIntegrate);
+
+	const int32 projectileCount = Projectiles.Num();
+
+	FProjectileIntegrationStream stream;
+	stream.PositionX = Projectiles.PositionX.GetData();
+	stream.PositionY = Projectiles.PositionY.GetData();
+	stream.PositionZ = Projectiles.PositionZ.GetData();
+	stream.VelocityX = Projectiles.VelocityX.GetData();
+	stream.VelocityY = Projectiles.VelocityY.GetData();
+	stream.VelocityZ = Projectiles.VelocityZ.GetData();
+	stream.GravityZ = Projectiles.GravityZ.GetData();
+	stream.LifeTime = Projectiles.LifeTime.GetData();
+	stream.Num = projectileCount;
+
+	// bit identical result either way, the cvar is there to compare cost in stat TPS
+	if (CVarProjectileVectorIntegrate.GetValueOnGameThread() != 0)
+	{
+		FProjectileIntegrator::IntegrateVector(stream, DeltaSeconds);
+	}
+	else
+	{
+		FProjectileIntegrator::IntegrateScalar(stream, DeltaSeconds);
+	}
+}
+
+void ATPS_ProjectileSimulation::UpdateSignificance()
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPS_ProjectileSignificance);
+
+	SignificanceViews.Reset();
+
+	for (FConstPlayerControllerIterator it = GetWorld()->GetPlayerControllerIterator(); it; ++it)
+	{
+		const APlayerController* playerController = it->Get();
+		if (playerController && playerController->IsLocalController() && playerController->PlayerCameraManager)
+		{
+			const FSignificanceView view = { playerController->PlayerCameraManager->GetCameraLocation(), playerController->PlayerCameraManager->GetCameraRotation().Vector() };
+			SignificanceViews.Add(view);
+		}
+	}
+
+	FMemory::Memzero(SignificanceCounts);
+
+	const int32 projectileCount = Projectiles.Num();
+
+	// no local view (dedicated server): everything stay Near, collision is what matters there
+	if (SignificanceViews.Num() == 0)
+	{
+		FMemory::Memset(Projectiles.Significance.GetData(), (uint8)EProjectileSignificance::Near, projectileCount);
+		SignificanceCounts[(int32)EProjectileSignificance::Near] = projectileCount;
+	}
+	else
+	{
+		const float nearDistanceSquared = NearDistance * NearDistance;
+		const float farDistanceSquared = FarDistance * FarDistance;
+
+		for (int32 i = 0; i < projectileCount; i++)
+		{
+			const FVector location(Projectiles.PositionX[i], Projectiles.PositionY[i], Projectiles.PositionZ[i]);
+
+			float minDistanceSquared = MAX_flt;
+			bool bIsInFront = false;
+
+			for (const FSignificanceView& view : SignificanceViews)
+			{
+				const FVector toProjectile = location - view.Location;
+				minDistanceSquared = FMath::Min(minDistanceSquared, toProjectile.SizeSquared());
+				bIsInFront |= FVector::DotProduct(toProjectile, view.Direction) > 0.0f;
+			}
+
+			EProjectileSignificance significance = EProjectileSignificance::Near;
+
+			if (minDistanceSquared > nearDistanceSquared)
+			{
+				if (!bIsInFront) significance = EProjectileSignificance::Hidden;
+				else if (minDistanceSquared > farDistanceSquared) significance = EProjectileSignificance::Far;
+				else significance = EProjectileSignificance::Mid;
+			}
+
+			Projectiles.Significance[i] = (uint8)significance;
+			SignificanceCounts[(int32)significance]++;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_TPS_ProjectileNear, SignificanceCounts[(int32)EProjectileSignificance::Near]);
+	SET_DWORD_STAT(STAT_TPS_ProjectileMid, SignificanceCounts[(int32)EProjectileSignificance::Mid]);
+	SET_DWORD_STAT(STAT_TPS_ProjectileFar, SignificanceCounts[(int32)EProjectileSignificance::Far]);
+	SET_DWORD_STAT(STAT_TPS_ProjectileHidden, SignificanceCounts[(int32)EProjectileSignificance::Hidden]);
+}
+
+void ATPS_ProjectileSimulation::SweepProjectiles()
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPS_ProjectileCollision);
+
+	UWorld* world = GetWorld();
+	const int32 projectileCount = Projectiles.Num();
+	const int32 forcedCollisionMode = CVarProjectileCollisionMode.GetValueOnGameThread();
+
+	Hits.Reset();
+
+	for (int32 i = 0; i < projectileCount; i++)
+	{
+		const FProjectileClassInfo& classInfo = ClassInfos[Projectiles.ClassIndex[i]];
+		const bool bAsyncSweep = (forcedCollisionMode < 0) ? classInfo.bAsyncSweep : forcedCollisionMode == 1;
+
+		// the sweep of last frame hit, this frame segment is not needed
+		if (ConsumeAsyncSweep(i, classInfo)) continue;
+
+		// retired this frame (RetireProjectiles), nothing could read an async sweep issued now
+		const bool bIsRetiring = Projectiles.LifeTime[i] <= 0.0f || IsOutOfWorld(i);
+
+		// less significant projectile sweep less often, over the longer segment since their last sweep
+		// one about to be retired is always swept, so its last segment is not skipped
+		if (!IsUpdateFrame(i) && !bIsRetiring) continue;
+
+		FCollisionQueryParams queryParams(SCENE_QUERY_STAT(ProjectileSweep), classInfo.bTraceComplex, Projectiles.Instigators[i].Get());
+		queryParams.bReturnPhysicalMaterial = true;
+
+		const FVector start(Projectiles.SweepStartX[i], Projectiles.SweepStartY[i], Projectiles.SweepStartZ[i]);
+		const FVector end(Projectiles.PositionX[i], Projectiles.PositionY[i], Projectiles.PositionZ[i]);
+		const FCollisionShape sphere = FCollisionShape::MakeSphere(Projectiles.Radius[i]);
+
+		Projectiles.SweepStartX[i] = end.X;
+		Projectiles.SweepStartY[i] = end.Y;
+		Projectiles.SweepStartZ[i] = end.Z;
+
+		if (bAsyncSweep && !bIsRetiring)
+		{
+			Projectiles.AsyncSweepStartX[i] = start.X;
+			Projectiles.AsyncSweepStartY[i] = start.Y;
+			Projectiles.AsyncSweepStartZ[i] = start.Z;
+			Projectiles.TraceHandles[i] = world->AsyncSweepByChannel(EAsyncTraceType::Single, start, end, classInfo.ObjectType, sphere, queryParams, classInfo.ResponseParams);
+			INC_DWORD_STAT(STAT_TPS_ProjectileAsyncSweep);
+			continue;
+		}
+
+		SweepSubSteps(i, start, end, classInfo, sphere, queryParams);
+	}
+}
+
+void ATPS_ProjectileSimulation::SweepSubSteps(const int32 Index, const FVector& Start, const FVector& End, const FProjectileClassInfo& ClassInfo, const FCollisionShape& Sphere, const FCollisionQueryParams& QueryParams)
+{
+	UWorld* world = GetWorld();
+	const float distance = FVector::Dist(Start, End);
+	const float speed = FVector(Projectiles.VelocityX[Index], Projectiles.VelocityY[Index], Projectiles.VelocityZ[Index]).Size();
+
+	// a long frame (hitch, low fps) is split, so the chords follow the arc and the hit is found on the right sub-step
+	const float subStepLength = FMath::Max(Projectiles.Radius[Index] * SubStepLengthInRadius, 1.0f);
+	const int32 subStepCount = FMath::Clamp(FMath::CeilToInt(distance / subStepLength), 1, FMath::Max(MaxSubSteps, 1));
+
+	// time the projectile took from Start to End
+	const float segmentTime = (speed > 0.0f) ? distance / speed : 0.0f;
+	const float gravityZ = Projectiles.GravityZ[Index];
+
+	FVector subStepStart = Start;
+	FHitResult hit;
+
+	for (int32 subStep = 1; subStep <= subStepCount; subStep++)
+	{
+		const float alpha = (float)subStep / subStepCount;
+		const float time = segmentTime * alpha;
+
+		// point of the arc between Start and End, the chord plus the gravity sag
+		FVector subStepEnd = FMath::Lerp(Start, End, alpha);
+		subStepEnd.Z += gravityZ * 0.5f * time * (time - segmentTime);
+
+		INC_DWORD_STAT(STAT_TPS_ProjectileSyncSweep);
+
+		if (world->SweepSingleByChannel(hit, subStepStart, subStepEnd, FQuat::Identity, ClassInfo.ObjectType, Sphere, QueryParams, ClassInfo.ResponseParams))
+		{
+			Hits.Add({ Index, hit });
+			return;
+		}
+
+		subStepStart = subStepEnd;
+	}
+}
+
+bool ATPS_ProjectileSimulation::ConsumeAsyncSweep(const int32 Index, const FProjectileClassInfo& ClassInfo)
+{
+	FTraceHandle& traceHandle = Projectiles.TraceHandles[Index];
+	if (!traceHandle.IsValid()) return false;
+
+	FTraceDatum traceDatum;
+	const bool bIsReady = GetWorld()->QueryTraceData(traceHandle, traceDatum);
+	traceHandle.Invalidate();
+
+	// never dropped: the segment would not be tested and the projectile could go through a wall
+	if (!bIsReady)
+	{
+		INC_DWORD_STAT(STAT_TPS_ProjectileAsyncSweepLate);
+
+		FCollisionQueryParams queryParams(SCENE_QUERY_STAT(ProjectileSweep), ClassInfo.bTraceComplex, Projectiles.Instigators[Index].Get());
+		queryParams.bReturnPhysicalMaterial = true;
+
+		const FVector start(Projectiles.AsyncSweepStartX[Index], Projectiles.AsyncSweepStartY[Index], Projectiles.AsyncSweepStartZ[Index]);
+		const FVector end(Projectiles.SweepStartX[Index], Projectiles.SweepStartY[Index], Projectiles.SweepStartZ[Index]);
+
+		const int32 hitCount = Hits.Num();
+		SweepSubSteps(Index, start, end, ClassInfo, FCollisionShape::MakeSphere(Projectiles.Radius[Index]), queryParams);
+		return Hits.Num() > hitCount;
+	}
+
+	for (const FHitResult& hit : traceDatum.OutHits)
+	{
+		if (hit.bBlockingHit)
+		{
+			// the projectile already moved one more frame, it is put back on the hit when retired
+			Hits.Add({ Index, hit });
+			return true;
+		}
+	}
+	return false;
+}
+
+void ATPS_ProjectileSimulation::RetireProjectiles()
+{
+	RetiredIndices.Reset();
+
+	for (const FProjectileHit& projectileHit : Hits)
+	{
+		const int32 i = projectileHit.Index;
+		const FHitResult& hit = projectileHit.Hit;
+
+		const FVector velocity(Projectiles.VelocityX[i], Projectiles.VelocityY[i], Projectiles.VelocityZ[i]);
+		const FTransform hitTransform(velocity.Rotation(), hit.Location, FVector(Projectiles.ParticleScale[i]));
+
+		ATPS_Projectile* visual = Projectiles.Visuals[i];
+
+		if (visual)
+		{
+			visual->SetActorLocation(hit.Location);
+			visual->NotifyHit(visual->GetCollisionComp(), hit.GetActor(), hit.GetComponent(), true, hit.Location, hit.Normal, FVector::ZeroVector, hit);
+			Projectiles.Visuals[i] = nullptr;
+		}
+		else
+		{
+			ATPS_Projectile::SpawnHitEffect(FXManager, Projectiles.HitResponses[i]->Resolve(hit), hitTransform);
+		}
+
+		Projectiles.LifeTime[i] = HitLifeTime;
+	}
+
+	// collected from the back, so a swapped in projectile is always one already checked
+	for (int32 i = Projectiles.Num() - 1; i >= 0; i--)
+	{
+		const float lifeTime = Projectiles.LifeTime[i];
+		const bool bIsOutOfWorld = IsOutOfWorld(i);
+
+		if (lifeTime > 0.0f && !bIsOutOfWorld) continue;
+
+		if (lifeTime == HitLifeTime)
+		{
+			// hit FX already played above
+			TotalHit++;
+		}
+		else if (bIsOutOfWorld)
+		{
+			TotalOutOfWorld++;
+			INC_DWORD_STAT(STAT_TPS_ProjectileOutOfWorld);
+		}
+		else
+		{
+			TotalExpired++;
+			INC_DWORD_STAT(STAT_TPS_ProjectileExpired);
+
+			const FVector location(Projectiles.PositionX[i], Projectiles.PositionY[i], Projectiles.PositionZ[i]);
+			const FVector velocity(Projectiles.VelocityX[i], Projectiles.VelocityY[i], Projectiles.VelocityZ[i]);
+			const FTransform noHitTransform(velocity.Rotation(), location, FVector(Projectiles.ParticleScale[i]));
+
+			ATPS_Projectile::SpawnHitEffect(FXManager, Projectiles.HitResponses[i]->NoHitResponse, noHitTransform);
+		}
+
+		RetiredIndices.Add(i);
+	}
+
+	for (const int32 i : RetiredIndices)
+	{
+		RetireProjectile(i);
+	}
+}
+
+void ATPS_ProjectileSimulation::UpdateVisuals()
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPS_ProjectileVisual);
+
+	const int32 projectileCount = Projectiles.Num();
+	int32 visualCount = 0;
+
+	for (int32 i = 0; i < projectileCount; i++)
+	{
+		ATPS_Projectile* visual = Projectiles.Visuals[i];
+		if (visual == nullptr) continue;
+
+		visualCount++;
+
+		const EProjectileSignificance significance = (EProjectileSignificance)Projectiles.Significance[i];
+		visual->SetTrailVisible(significance == EProjectileSignificance::Near || significance == EProjectileSignificance::Mid);
+
+		if (!IsUpdateFrame(i)) continue;
+
+		const FVector location(Projectiles.PositionX[i], Projectiles.PositionY[i], Projectiles.PositionZ[i]);
+		const FVector velocity(Projectiles.VelocityX[i], Projectiles.VelocityY[i], Projectiles.VelocityZ[i]);
+
+		visual->SetActorLocationAndRotation(location, velocity.Rotation());
+	}
+
+	SET_DWORD_STAT(STAT_TPS_ProjectileVisualCount, visualCount);
+}
+
+bool ATPS_ProjectileSimulation::IsOutOfWorld(const int32 Index) const
+{
+	return Projectiles.PositionZ[Index] < KillZ
+		|| FMath::Abs(Projectiles.PositionX[Index]) > HALF_WORLD_MAX
+		|| FMath::Abs(Projectiles.PositionY[Index]) > HALF_WORLD_MAX
+		|| FMath::Abs(Projectiles.PositionZ[Index]) > HALF_WORLD_MAX;
+}
+
+void ATPS_ProjectileSimulation::RetireProjectile(const int32 Index)
+{
+	ATPS_Projectile* visual = Projectiles.Visuals[Index];
+
+	if (visual && ProjectilePool)
+	{
+		ProjectilePool->ReleaseProjectile(visual);
+	}
+
+	Projectiles.RemoveAtSwap(Index);
+}
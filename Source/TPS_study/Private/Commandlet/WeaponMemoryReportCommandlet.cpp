@@ -0,0 +1,55 @@
+#include "Commandlet/WeaponMemoryReportCommandlet.h"
+#include "Engine/DataTable.h"
+
+#include "Library/ProjectileAssetStreamer.h"
+#include "Library/WeaponSpecCache.h"
+
+//===========================================================================
+// public function:
+//===========================================================================
+
+UWeaponMemoryReportCommandlet::UWeaponMemoryReportCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UWeaponMemoryReportCommandlet::Main(const FString& Params)
+{
+	FString tablePath(TEXT("/Game/Character/Table/WeaponTable.WeaponTable"));
+	FParse::Value(*Params, TEXT("Table="), tablePath);
+
+	const UDataTable* weaponTable = LoadObject<UDataTable>(nullptr, *tablePath);
+	if (weaponTable == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Weapon memory report: no weapon table at %s"), *tablePath);
+		return 1;
+	}
+
+	const FWeaponSpecTable* weaponSpecs = FWeaponSpecCache::GetWeaponSpecs(weaponTable);
+
+	SIZE_T totalBytes = 0;
+
+	// one weapon equipped at a time, what each one add when it is
+	for (int32 i = 0; i < weaponSpecs->Num(); i++)
+	{
+		const FProjectileSpec& projectileSpec = weaponSpecs->WeaponSpecs[i].Projectile;
+
+		FProjectileAssetStreamer::AddOwner(projectileSpec);
+		FProjectileAssetStreamer::LoadSynchronous(projectileSpec);
+
+		const SIZE_T residentBytes = FProjectileAssetStreamer::GetResidentBytes(projectileSpec);
+		totalBytes += residentBytes;
+
+		UE_LOG(LogTemp, Display, TEXT("%s: %.1f KB"), *weaponSpecs->WeaponNames[i].ToString(), residentBytes / 1024.0f);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("weapon %i, sum of equipped %.1f KB"), weaponSpecs->Num(), totalBytes / 1024.0f);
+
+	// every weapon owned at once, shared FX counted once
+	FProjectileAssetStreamer::DumpResidentAssets(*GLog);
+
+	return 0;
+}
@@ -3,9 +3,10 @@
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/SpringArmComponent.h"
-#include "TimerManager.h"
 
 #include "Component/RangedWeaponComponent.h"
+#include "Custom/TPSStats.h"
+#include "Library/AimingProfileCache.h"
 
 #include "Engine/Engine.h"
 #include "Kismet/GameplayStatics.h"
@@ -16,15 +17,20 @@
 
 UAimingComponent::UAimingComponent()
 {
+	// only tick while TransitioningAiming
 	PrimaryComponentTick.bCanEverTick = true;
-	
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
 	SetUpVariables(bShouldDoCheckFile);
 }
 
 void UAimingComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	DeltaSecond = DeltaTime;
+
+	INC_DWORD_STAT(STAT_TPS_AimingTick);
+
+	UpdateAimingTransition(DeltaTime);
 }
 
 //=================
@@ -49,15 +55,13 @@ bool UAimingComponent::GetTransitioningAiming() const
 void UAimingComponent::AimingPress()
 {
 	bIsAimingForward = true;
-	ClearAndStartAimingTimer();
-	UE_LOG(LogTemp, Log, TEXT("Start Timer"));
+	StartAimingTransition();
 }
 
 void UAimingComponent::AimingRelease()
 {
 	bIsAimingForward = false;
-	ClearAndStartAimingTimer();
-	UE_LOG(LogTemp, Log, TEXT("STOP Timer DELTA seconds is %f"), DeltaSecond);
+	StartAimingTransition();
 }
 
 float UAimingComponent::GetAimingAlpha() const
@@ -71,7 +75,7 @@ float UAimingComponent::GetAimingAlpha() const
 
 void UAimingComponent::SetIsTransitioningAiming(bool bInBool)
 {
-	if (bInBool) AimingState = EAimingState::TransitioningAiming;
+	if (bInBool) StartAimingTransition();
 }
 
 //===========================================================================
@@ -80,6 +84,8 @@ void UAimingComponent::SetIsTransitioningAiming(bool bInBool)
 
 void UAimingComponent::BeginPlay()
 {
+	SCOPE_CYCLE_COUNTER(STAT_TPS_AimingBeginPlay);
+
 	Super::BeginPlay();
 
 	CameraComponent =  GetComponentSibling<UCameraComponent>();
@@ -89,30 +95,14 @@ void UAimingComponent::BeginPlay()
 	SetUpVariables(bShouldDoCheckFile);
 
 	// aiming setup:
-	if (AimStats.Num() == 0) { AimStats.SetNum(1); };
-	AimStats[0].CamBoom.SocketOffset = CameraBoomComponent->SocketOffset;
-	AimStats[0].CamBoom.TargetArmLength = CameraBoomComponent->TargetArmLength;
-	AimStats[0].CharMov.MaxAcceleration = GetCharacterMovement()->MaxAcceleration;
-	AimStats[0].CharMov.MaxWalkSpeed = GetCharacterMovement()->MaxWalkSpeed;
-	AimStats[0].FollCam.FieldOfView = CameraComponent->FieldOfView;
-
-	AimingNames = AimingTable->GetRowNames();
-
-	int aimingNamesCount = AimingNames.Num();
-	FName currentAimingName;
-	static const FString contextString(TEXT("Aiming name"));
-	struct FAimingStatCompact* aimStatRow;
-	AimStats.SetNum(1 + aimingNamesCount);
-	UKismetSystemLibrary::PrintString(this, TEXT("added aiming table start loop"), true, false, FLinearColor::Red, 5.0f);
-	for (int i = 0; i < AimingNames.Num(); i++)
-	{
-		currentAimingName = AimingNames[i];
-		aimStatRow = AimingTable->FindRow<FAimingStatCompact>(currentAimingName, contextString, true);
-		AimStats[1 + i].CamBoom = aimStatRow->AimStat.CamBoom;
-		AimStats[1 + i].CharMov = aimStatRow->AimStat.CharMov;
-		AimStats[1 + i].FollCam = aimStatRow->AimStat.FollCam;
-		UKismetSystemLibrary::PrintString(this, TEXT("added aiming table in aimstat"), true, false, FLinearColor::Red, 5.0f);
-	}
+	DefaultAimStat.CamBoom.SocketOffset = CameraBoomComponent->SocketOffset;
+	DefaultAimStat.CamBoom.TargetArmLength = CameraBoomComponent->TargetArmLength;
+	DefaultAimStat.CharMov.MaxAcceleration = GetCharacterMovement()->MaxAcceleration;
+	DefaultAimStat.CharMov.MaxWalkSpeed = GetCharacterMovement()->MaxWalkSpeed;
+	DefaultAimStat.FollCam.FieldOfView = CameraComponent->FieldOfView;
+
+	// no FindRow and no row copy per character, the table is read once
+	AimingProfiles = FAimingProfileCache::GetAimingProfiles(AimingTable);
 }
 
 void UAimingComponent::SetUpVariables(bool bShouldCheck)
@@ -147,75 +137,73 @@ UCharacterMovementComponent* UAimingComponent::GetCharacterMovement()
 	return Cast<ACharacter>(GetOwner())->GetCharacterMovement();
 }
 
-void UAimingComponent::AimingTimerStart()
+const FAimingStat& UAimingComponent::GetAimStat(const int32 AimStatIndex) const
+{
+	if (AimStatIndex <= 0 || AimingProfiles == nullptr || AimStatIndex > AimingProfiles->Num()) return DefaultAimStat;
+
+	return AimingProfiles->AimStats[AimStatIndex - 1];
+}
+
+void UAimingComponent::StartAimingTransition()
 {
 	AimingState = EAimingState::TransitioningAiming;
+	SetComponentTickEnabled(true);
 
-	//OnTransitioningAiming.Broadcast(this);
-	TimeAiming(AimingAlpha);
-	AimingAlpha = AimingCurve->GetFloatValue(CurrentAimingTime / TotalAimingTime);
-	//OnAiming.Broadcast(this);
-	UE_LOG(LogTemp, Log, TEXT("Aiming Alpha is %f, current time is %f"), AimingAlpha, CurrentAimingTime);
+	OnTransitioningAiming.Broadcast(this);
+}
 
-	float incrementTime = (bIsAimingForward) ? DeltaSecond : -1 * DeltaSecond;
-	CurrentAimingTime += incrementTime;
+void UAimingComponent::UpdateAimingTransition(const float DeltaTime)
+{
+	if (AimingState != EAimingState::TransitioningAiming)
+	{
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	// real frame delta, the end of the transition is reached exactly
+	const float incrementTime = (bIsAimingForward) ? DeltaTime : -DeltaTime;
+	CurrentAimingTime = FMath::Clamp(CurrentAimingTime + incrementTime, 0.0f, TotalAimingTime);
+
+	AimingAlpha = AimingCurve->GetFloatValue(CurrentAimingTime / FMath::Max(TotalAimingTime, KINDA_SMALL_NUMBER));
+	TimeAiming(AimingAlpha);
 
 	if (bIsAimingForward)
 	{
 		if (CurrentAimingTime >= TotalAimingTime)
 		{
 			AimingState = EAimingState::Aiming;
+			SetComponentTickEnabled(false);
 
-			ClearAndInvalidateAimingTimer(TotalAimingTime);
-			//TimeAiming(AimingAlpha);
 			OnAiming.Broadcast(this);
 			OrientCharacter(true);
-			UE_LOG(LogTemp, Log, TEXT("FINISH >>>>>>> current time is %f"), CurrentAimingTime);
 		}
 	}
 	else if (CurrentAimingTime <= 0.0f)
 	{
 		AimingState = EAimingState::NotAiming;
+		SetComponentTickEnabled(false);
+
 		OnStopAiming.Broadcast(this);
-		//TimeAiming(AimingAlpha);
 		OrientCharacter(false);
-		ClearAndInvalidateAimingTimer(0.0f);
-		UE_LOG(LogTemp, Log, TEXT("<<<<<<<<<<<FINISH  current time is %f"), CurrentAimingTime);
 	}
 }
 
-void UAimingComponent::ClearAndStartAimingTimer()
-{
-	GetOwner()->GetWorldTimerManager().ClearTimer(AimingTimerHandle);
-	GetOwner()->GetWorldTimerManager().SetTimer(AimingTimerHandle, this, &UAimingComponent::AimingTimerStart, DeltaSecond, true);
-	OnTransitioningAiming.Broadcast(this);
-}
-
-void UAimingComponent::ClearAndInvalidateAimingTimer(const float NewCurrentTime)
-{
-	GetOwner()->GetWorldTimerManager().ClearTimer(AimingTimerHandle);
-	AimingTimerHandle.Invalidate();
-	CurrentAimingTime = NewCurrentTime;
-}
-
 void UAimingComponent::TimeAiming(float InAlpha)
 {
-	UE_LOG(LogTemp, Log, TEXT("aimstats number %i"), AimStats.Num());
-
-	int32 A = AimStatStartIndex;
-	int32 B = AimStatTargetIndex;
+	const FAimingStat& A = GetAimStat(AimStatStartIndex);
+	const FAimingStat& B = GetAimStat(AimStatTargetIndex);
 
-	float defaultFieldOfView = AimStats[A].FollCam.FieldOfView;
-	float defaultMaxAcceleration = AimStats[A].CharMov.MaxAcceleration;
-	float defaultTargetArmLength = AimStats[A].CamBoom.TargetArmLength;
-	float defaultWalkSpeed = AimStats[A].CharMov.MaxWalkSpeed;
-	FVector defaultSocketOffset = AimStats[A].CamBoom.SocketOffset;
+	float defaultFieldOfView = A.FollCam.FieldOfView;
+	float defaultMaxAcceleration = A.CharMov.MaxAcceleration;
+	float defaultTargetArmLength = A.CamBoom.TargetArmLength;
+	float defaultWalkSpeed = A.CharMov.MaxWalkSpeed;
+	FVector defaultSocketOffset = A.CamBoom.SocketOffset;
 
-	float aimingFieldOfView = AimStats[B].FollCam.FieldOfView;
-	float aimingMaxAcceleration = AimStats[B].CharMov.MaxAcceleration;
-	float aimingTargetArmLength = AimStats[B].CamBoom.TargetArmLength;
-	float aimingWalkSpeed = AimStats[B].CharMov.MaxWalkSpeed;
-	FVector aimingSocketOffset = AimStats[B].CamBoom.SocketOffset;
+	float aimingFieldOfView = B.FollCam.FieldOfView;
+	float aimingMaxAcceleration = B.CharMov.MaxAcceleration;
+	float aimingTargetArmLength = B.CamBoom.TargetArmLength;
+	float aimingWalkSpeed = B.CharMov.MaxWalkSpeed;
+	FVector aimingSocketOffset = B.CamBoom.SocketOffset;
 
 	CameraBoomComponent->TargetArmLength = FMath::Lerp(defaultTargetArmLength, aimingTargetArmLength, InAlpha);
 	CameraBoomComponent->SocketOffset = FMath::Lerp(defaultSocketOffset, aimingSocketOffset, InAlpha);
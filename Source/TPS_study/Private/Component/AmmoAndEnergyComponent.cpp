@@ -61,18 +61,18 @@ void UAmmoAndEnergyComponent::AddEnergy(const EEnergyType InEnergyType, const fl
 
 bool UAmmoAndEnergyComponent::IsAmmoEnough()
 {
-	if (RangedWeaponComponent->CurrentWeapon.WeaponCost == EWeaponCost::Nothing)
+	if (RangedWeaponComponent->CurrentWeapon->WeaponCost == EWeaponCost::Nothing)
 	{
 		return true;
 	}
 
-	switch (RangedWeaponComponent->CurrentWeapon.WeaponCost)
+	switch (RangedWeaponComponent->CurrentWeapon->WeaponCost)
 	{
 	case EWeaponCost::Ammo:
-		return IsAmmoEnough(RangedWeaponComponent->CurrentWeapon.AmmoType);
+		return IsAmmoEnough(RangedWeaponComponent->CurrentWeapon->AmmoType);
 
 	case EWeaponCost::Energy:
-		return IsAmmoEnough(RangedWeaponComponent->CurrentWeapon.EnergyType);
+		return IsAmmoEnough(RangedWeaponComponent->CurrentWeapon->EnergyType);
 
 	default:
 		return false;
@@ -134,13 +134,13 @@ bool UAmmoAndEnergyComponent::IsAmmoEnough(const EEnergyType InEnergyType)
 	switch (InEnergyType)
 	{
 	case EEnergyType::MP:
-		return IsAmmoEnough(EnergyExternal.MP, RangedWeaponComponent->CurrentWeapon.EnergyUsePerShot);
+		return IsAmmoEnough(EnergyExternal.MP, RangedWeaponComponent->CurrentWeapon->EnergyUsePerShot);
 
 	case EEnergyType::Fuel:
-		return IsAmmoEnough(EnergyExternal.Fuel, RangedWeaponComponent->CurrentWeapon.EnergyUsePerShot);
+		return IsAmmoEnough(EnergyExternal.Fuel, RangedWeaponComponent->CurrentWeapon->EnergyUsePerShot);
 
 	case EEnergyType::Battery:
-		return IsAmmoEnough(EnergyExternal.Battery, RangedWeaponComponent->CurrentWeapon.EnergyUsePerShot);
+		return IsAmmoEnough(EnergyExternal.Battery, RangedWeaponComponent->CurrentWeapon->EnergyUsePerShot);
 
 	case EEnergyType::Overheat:
 		return IsWeaponNotOverheating();
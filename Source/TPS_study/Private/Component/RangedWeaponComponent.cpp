@@ -1,14 +1,23 @@
 #include "Component/RangedWeaponComponent.h"
 
+#include "AudioDevice.h"
 #include "Camera/CameraComponent.h"
+#include "Components/AudioComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/CurveTable.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/SkeletalMeshSocket.h"
 #include "Gameframework/Character.h"
 #include "TimerManager.h"
 //#include "UObject/ConstructorHelpers.h"
 
 #include "Actor/TPS_Projectile.h"
+#include "Actor/TPS_ProjectileSimulation.h"
 #include "Component/AimingComponent.h"
 #include "Component/AmmoAndEnergyComponent.h"
 #include "Component/HPandMPComponent.h"
+#include "Custom/TPSStats.h"
+#include "Library/ProjectileAssetStreamer.h"
 
 #include "Engine/Engine.h"
 #include "Kismet/GameplayStatics.h"
@@ -19,9 +28,19 @@
 
 URangedWeaponComponent::URangedWeaponComponent()
 {
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
 	SetUpVariables(bShouldDoCheckFile);
 }
 
+void URangedWeaponComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	FireDueRounds();
+}
+
 //=================
 // Getter (public):
 //=================
@@ -31,11 +50,53 @@ int32 URangedWeaponComponent::GetWeaponIndex() const { return WeaponIndex; }
 
 int32 URangedWeaponComponent::GetLastWeaponIndex() const { return LastWeaponIndex; }
 
-FName URangedWeaponComponent::GetWeaponName() const { return WeaponNames[WeaponIndex]; }
+FName URangedWeaponComponent::GetWeaponName() const { return (*WeaponNames)[WeaponIndex]; }
 
 bool URangedWeaponComponent::GetIsTriggerPressed() const { return bIsTriggerPressed; }
 
-ETriggerMechanism URangedWeaponComponent::GetTriggerMechanism() const { return CurrentWeapon.Trigger; }
+ETriggerMechanism URangedWeaponComponent::GetTriggerMechanism() const { return CurrentWeapon->Trigger; }
+
+float URangedWeaponComponent::GetCurrentRPM() const { return CurrentWeapon->GetRoundsPerSecond(GetSpinAlpha()) * 60.0f; }
+
+float URangedWeaponComponent::GetHoldTime() const
+{
+	return HoldTrigger.GetHoldTime(GetWorld()->GetTimeSeconds());
+}
+
+float URangedWeaponComponent::GetChargeFraction() const
+{
+	return HoldTrigger.GetChargeFraction(GetWorld()->GetTimeSeconds(), MaxFireHoldTime);
+}
+
+int32 URangedWeaponComponent::GetActiveFireVoiceCount() const
+{
+	int32 voiceCount = 0;
+
+	if (FireLoopVoice && FireLoopVoice->IsPlaying()) voiceCount++;
+	if (FireTailVoice && FireTailVoice->IsPlaying()) voiceCount++;
+
+	for (const UAudioComponent* muzzleVoice : MuzzleVoices)
+	{
+		if (muzzleVoice && muzzleVoice->IsPlaying()) voiceCount++;
+	}
+	return voiceCount;
+}
+
+float URangedWeaponComponent::GetSpinAlpha() const
+{
+	if (!CurrentWeapon->bHasSpinUp) return 1.0f;
+
+	const float elapsedTime = GetWorld()->GetTimeSeconds() - SpinChangeTime;
+
+	if (bIsSpinningUp)
+	{
+		if (CurrentWeapon->SpinUpTime <= 0.0f) return 1.0f;
+		return FMath::Min(SpinAlphaAtChange + elapsedTime / CurrentWeapon->SpinUpTime, 1.0f);
+	}
+
+	if (CurrentWeapon->SpinDownTime <= 0.0f) return 0.0f;
+	return FMath::Max(SpinAlphaAtChange - elapsedTime / CurrentWeapon->SpinDownTime, 0.0f);
+}
 
 //==================================
 // Function for Controller (public):
@@ -46,9 +107,18 @@ void URangedWeaponComponent::FirePress()
 	bIsTriggerPressed = true;
 	bOnePressToggle = (bOnePressToggle) ? false : true;
 
+	StartSpin(CurrentWeapon->Trigger == ETriggerMechanism::OnePressAutoTrigger ? bOnePressToggle : true);
+
+	// keep scheduling while held, even if the first round is not ready yet
+	if (CurrentWeapon->Trigger == ETriggerMechanism::AutomaticTrigger || CurrentWeapon->Trigger == ETriggerMechanism::OnePressAutoTrigger)
+	{
+		if (IsAutomaticFireHeld()) SetComponentTickEnabled(true);
+		else StopAutomaticFire();
+	}
+
 	if (!IsWeaponAbleToFire()) { return; }
 
-	switch (CurrentWeapon.Trigger)
+	switch (CurrentWeapon->Trigger)
 	{
 	case ETriggerMechanism::PressTrigger:
 		FireStandardTrigger();
@@ -75,7 +145,13 @@ void URangedWeaponComponent::FireRelease()
 {
 	bIsTriggerPressed = false;
 
-	if (CurrentWeapon.Trigger == ETriggerMechanism::ReleaseTrigger)
+	if (CurrentWeapon->Trigger != ETriggerMechanism::OnePressAutoTrigger)
+	StartSpin(false);
+
+	if (CurrentWeapon->Trigger == ETriggerMechanism::AutomaticTrigger)
+	StopAutomaticFire();
+
+	if (CurrentWeapon->Trigger == ETriggerMechanism::ReleaseTrigger)
 	FireReleaseAfterHold();
 }
 
@@ -95,20 +171,64 @@ void URangedWeaponComponent::BeginPlay()
 	AimingComponent = GetComponentSibling<UAimingComponent>();
 	AmmoComponent = GetComponentSibling<UAmmoAndEnergyComponent>();
 	MPComponent = GetComponentSibling<UHPandMPComponent>();
+	ProjectileSimulation = UTPSFunctionLibrary::GetWorldManager<ATPS_ProjectileSimulation>(this);
+
+	// built once, the fire path should not allocate
+	AimQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(WeaponAimTrace), false, GetOwner());
 
 	SetUpVariables(bShouldDoCheckFile);
 
-	WeaponNames = WeaponTable->GetRowNames();
+	WeaponSpecs = FWeaponSpecCache::GetWeaponSpecs(WeaponTable, RPMTable);
+	WeaponNames = &WeaponSpecs->WeaponNames;
+
+	// every row can be switched to, its FX and sound are loaded when it is equipped
+	for (const FWeaponSpec& weaponSpec : WeaponSpecs->WeaponSpecs)
+	{
+		FProjectileAssetStreamer::AddOwner(weaponSpec.Projectile);
+	}
+
+	AssetsReleasedHandle = FProjectileAssetStreamer::OnAssetsReleased.AddUObject(this, &URangedWeaponComponent::OnProjectileAssetsReleased);
+	AssetsLoadedHandle = FProjectileAssetStreamer::OnAssetsLoaded.AddUObject(this, &URangedWeaponComponent::OnProjectileAssetsLoaded);
+
 	SetWeaponMode(0);
 	SetWeaponMesh();
 }
 
+void URangedWeaponComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetOwner()->GetWorldTimerManager().ClearTimer(TimerOfPrewarm);
+	FProjectileAssetStreamer::OnAssetsLoaded.Remove(AssetsLoadedHandle);
+
+	// dropped, a bundle nobody else own is released
+	if (WeaponSpecs)
+	{
+		for (const FWeaponSpec& weaponSpec : WeaponSpecs->WeaponSpecs)
+		{
+			FProjectileAssetStreamer::RemoveOwner(weaponSpec.Projectile);
+		}
+	}
+
+	// after RemoveOwner, so the voices of this shooter are cleared too
+	FProjectileAssetStreamer::OnAssetsReleased.Remove(AssetsReleasedHandle);
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void URangedWeaponComponent::SetUpVariables(bool bShouldCheck)
 {
-	if (WeaponTable != nullptr) return;
-	static ConstructorHelpers::FObjectFinder<UDataTable> thisObj(TEXT("DataTable'/Game/Character/Table/WeaponTable.WeaponTable'"));
-	if (bShouldCheck) check(thisObj.Object);
-	WeaponTable = thisObj.Object;
+	if (WeaponTable == nullptr)
+	{
+		static ConstructorHelpers::FObjectFinder<UDataTable> thisObj(TEXT("DataTable'/Game/Character/Table/WeaponTable.WeaponTable'"));
+		if (bShouldCheck) check(thisObj.Object);
+		WeaponTable = thisObj.Object;
+	}
+
+	// optional, weapon without spin up just use their fire rate
+	if (RPMTable == nullptr)
+	{
+		static ConstructorHelpers::FObjectFinder<UCurveTable> rpmTable(TEXT("CurveTable'/Game/DataAsset/Projectile/AssaultRifleRPM.AssaultRifleRPM'"));
+		RPMTable = rpmTable.Object;
+	}
 }
 
 //===========================================================================
@@ -122,9 +242,9 @@ void URangedWeaponComponent::SetWeaponIndex(bool isUp)
 	if (true/*Shooter->IsAbleToSwitchWeapon()*/)
 	{
 		int32 inCounter = isUp ? 1 : -1;
-		int32 withinRange = (WeaponIndex + inCounter) % WeaponNames.Num();
+		int32 withinRange = (WeaponIndex + inCounter) % WeaponNames->Num();
 
-		WeaponIndex = (withinRange >= 0) ? withinRange : WeaponNames.Num() - 1;
+		WeaponIndex = (withinRange >= 0) ? withinRange : WeaponNames->Num() - 1;
 		SetWeaponMode(WeaponIndex);
 		OnSwitchWeapon.Broadcast(this);
 	}
@@ -132,11 +252,11 @@ void URangedWeaponComponent::SetWeaponIndex(bool isUp)
 
 void URangedWeaponComponent::SetWeaponIndex(const int32 InNumber)
 {
-	if (InNumber >= WeaponNames.Num()) { return; }
+	if (InNumber >= WeaponNames->Num()) { return; }
 
 	LastWeaponIndex = WeaponIndex;
 
-	if ((WeaponNames.Num() > WeaponIndex)/* && Shooter->IsAbleToSwitchWeapon()*/)
+	if ((WeaponNames->Num() > WeaponIndex)/* && Shooter->IsAbleToSwitchWeapon()*/)
 	{
 		WeaponIndex = InNumber;
 		SetWeaponMode(WeaponIndex);
@@ -146,28 +266,100 @@ void URangedWeaponComponent::SetWeaponIndex(const int32 InNumber)
 
 void URangedWeaponComponent::SetWeaponMode(const int32 MyWeaponIndex)
 {
-	FName CurrentWeaponName = WeaponNames[MyWeaponIndex];
-	static const FString ContextString(TEXT("Weapon Mode"));
-	struct FWeaponModeCompact* WeaponModeRow;
-	WeaponModeRow = WeaponTable->FindRow<FWeaponModeCompact>(CurrentWeaponName, ContextString, true);
+	SCOPE_CYCLE_COUNTER(STAT_TPS_WeaponSwitch);
+
+	// the tail is the one of the weapon that was firing
+	if (CurrentWeapon) StopFireLoop();
 
-	if (WeaponModeRow)
+	// no FindRow and no FWeaponMode copy, the spec is built once per table
+	CurrentWeapon = &WeaponSpecs->WeaponSpecs[MyWeaponIndex];
+	MaxFireHoldTime = CurrentWeapon->MaxHoldTime;
+
+	// load on equip, usually done before the first trigger pull (see FireRound)
+	FProjectileAssetStreamer::RequestAsyncLoad(CurrentWeapon->Projectile);
+
+	// the switch frame already does enough, the rest is done a little later
+	bIsFirstShotAfterSwitch = true;
+	if (PrewarmDelay >= 0.0f)
 	{
-		FWeaponMode CurrentWeaponMode = WeaponModeRow->WeaponMode;
+		GetOwner()->GetWorldTimerManager().SetTimer(TimerOfPrewarm, this, &URangedWeaponComponent::PrewarmNeighbourWeapons, FMath::Max(PrewarmDelay, KINDA_SMALL_NUMBER), false);
+	}
 
-		//Shooter->ShooterState = CurrentWeaponMode.Shooter;
-		CurrentWeapon = CurrentWeaponMode.Weapon;
-		CurrentProjectile = CurrentWeaponMode.Projectile;
+	// the new weapon start from rest
+	SpinAlphaAtChange = 0.0f;
+	SpinChangeTime = GetWorld()->GetTimeSeconds();
+	bIsSpinningUp = bIsTriggerPressed;
 
-		if (CurrentWeapon.FireRateAndOther.Num() >= 2)
-		{
-			MaxFireHoldTime = CurrentWeapon.FireRateAndOther[1];
-		}
-		else
+	ResolveMuzzleSockets();
+}
+
+void URangedWeaponComponent::PrewarmNeighbourWeapons()
+{
+	TArray<const FWeaponSpec*, TInlineAllocator<3>> neighbourWeapons;
+	GetNeighbourWeapons(neighbourWeapons);
+
+	for (const FWeaponSpec* weaponSpec : neighbourWeapons)
+	{
+		// owned already, so this only start the load of a neighbour
+		FProjectileAssetStreamer::RequestAsyncLoad(weaponSpec->Projectile);
+
+		// not loaded yet, done by OnProjectileAssetsLoaded, no polling
+		PrewarmWeapon(*weaponSpec);
+	}
+}
+
+void URangedWeaponComponent::GetNeighbourWeapons(TArray<const FWeaponSpec*, TInlineAllocator<3>>& OutWeapons) const
+{
+	const int32 weaponCount = WeaponSpecs->Num();
+	const int32 currentIndex = CurrentWeapon - WeaponSpecs->WeaponSpecs.GetData();
+
+	for (const int32 index : { currentIndex, (currentIndex + 1) % weaponCount, (currentIndex + weaponCount - 1) % weaponCount })
+	{
+		OutWeapons.AddUnique(&WeaponSpecs->WeaponSpecs[index]);
+	}
+}
+
+void URangedWeaponComponent::OnProjectileAssetsLoaded(const FProjectileSpec& LoadedSpec)
+{
+	// pre-warm is off, or still waiting for PrewarmDelay and done then
+	if (PrewarmDelay < 0.0f || CurrentWeapon == nullptr || GetOwner()->GetWorldTimerManager().IsTimerActive(TimerOfPrewarm)) return;
+
+	TArray<const FWeaponSpec*, TInlineAllocator<3>> neighbourWeapons;
+	GetNeighbourWeapons(neighbourWeapons);
+
+	for (const FWeaponSpec* weaponSpec : neighbourWeapons)
+	{
+		if (&weaponSpec->Projectile == &LoadedSpec) PrewarmWeapon(*weaponSpec);
+	}
+}
+
+bool URangedWeaponComponent::PrewarmWeapon(const FWeaponSpec& MyWeapon)
+{
+	if (PrewarmedWeapons.Contains(&MyWeapon)) return true;
+
+	const FProjectileSpec& projectileSpec = MyWeapon.Projectile;
+	if (!projectileSpec.bAssetsResolved) return false;
+
+	SCOPE_CYCLE_COUNTER(STAT_TPS_WeaponPrewarm);
+	INC_DWORD_STAT(STAT_TPS_WeaponPrewarmCount);
+
+	if (ProjectileSimulation) ProjectileSimulation->PrewarmProjectile(projectileSpec);
+
+	// decompressed now instead of on the first play
+	if (FAudioDevice* audioDevice = GetWorld()->GetAudioDevice())
+	{
+		TArray<USoundWave*> soundWaves;
+		FProjectileAssetStreamer::GetSoundWaves(projectileSpec, soundWaves);
+
+		for (USoundWave* soundWave : soundWaves)
 		{
-			MaxFireHoldTime = CurrentWeapon.FireRateAndOther[0];
+			audioDevice->Precache(soundWave);
 		}
 	}
+
+	PrewarmedWeapons.Add(&MyWeapon);
+
+	return true;
 }
 
 //================
@@ -178,6 +370,75 @@ void URangedWeaponComponent::SetWeaponMesh()
 {
 	USkeletalMeshComponent* weaponMesh = Cast<ACharacter>(GetOwner())->GetMesh(); // change it to accept additional weapon mesh later
 	WeaponInWorld = Cast<USceneComponent>(weaponMesh);
+
+	ResolveMuzzleSockets();
+}
+
+void URangedWeaponComponent::ResolveMuzzleSockets()
+{
+	MuzzleTransformFrame = MAX_uint64;
+
+	if (WeaponInWorld == nullptr || CurrentWeapon == nullptr) return;
+
+	USkeletalMeshComponent* skeletalMesh = Cast<USkeletalMeshComponent>(WeaponInWorld);
+
+	for (int32 i = 0; i < CurrentWeapon->MuzzleCount; i++)
+	{
+		const FName muzzleName = CurrentWeapon->MuzzleNames[i];
+		FResolvedMuzzle& resolvedMuzzle = ResolvedMuzzles[i];
+
+		resolvedMuzzle.BoneIndex = INDEX_NONE;
+		resolvedMuzzle.LocalTransform = FTransform::Identity;
+
+		if (skeletalMesh == nullptr || skeletalMesh->SkeletalMesh == nullptr) continue;
+
+		// socket name search done once here, instead of in every GetSocketTransform
+		if (const USkeletalMeshSocket* socket = skeletalMesh->SkeletalMesh->FindSocket(muzzleName))
+		{
+			resolvedMuzzle.BoneIndex = skeletalMesh->GetBoneIndex(socket->BoneName);
+			resolvedMuzzle.LocalTransform = socket->GetSocketLocalTransform();
+		}
+		else
+		{
+			resolvedMuzzle.BoneIndex = skeletalMesh->GetBoneIndex(muzzleName);
+		}
+	}
+}
+
+const FTransform& URangedWeaponComponent::GetMuzzleTransform(const int32 MuzzleIndex)
+{
+	if (MuzzleTransformFrame != GFrameCounter)
+	{
+		UpdateMuzzleTransforms();
+	}
+
+	return MuzzleTransforms[MuzzleIndex];
+}
+
+void URangedWeaponComponent::UpdateMuzzleTransforms()
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPS_MuzzleTransform);
+
+	// bone transforms change at most once a frame (animation), so all muzzles are read in one go
+	MuzzleTransformFrame = GFrameCounter;
+
+	USkeletalMeshComponent* skeletalMesh = Cast<USkeletalMeshComponent>(WeaponInWorld);
+	const TArray<FTransform>* componentSpaceTransforms = skeletalMesh ? &skeletalMesh->GetComponentSpaceTransforms() : nullptr;
+	const FTransform& componentToWorld = WeaponInWorld->GetComponentTransform();
+
+	for (int32 i = 0; i < CurrentWeapon->MuzzleCount; i++)
+	{
+		const FResolvedMuzzle& resolvedMuzzle = ResolvedMuzzles[i];
+
+		if (componentSpaceTransforms && componentSpaceTransforms->IsValidIndex(resolvedMuzzle.BoneIndex))
+		{
+			MuzzleTransforms[i] = resolvedMuzzle.LocalTransform * (*componentSpaceTransforms)[resolvedMuzzle.BoneIndex] * componentToWorld;
+		}
+		else
+		{
+			MuzzleTransforms[i] = WeaponInWorld->GetSocketTransform(CurrentWeapon->MuzzleNames[i]);
+		}
+	}
 }
 
 void URangedWeaponComponent::FireAutomaticTrigger()
@@ -188,8 +449,29 @@ void URangedWeaponComponent::FireAutomaticTrigger()
 
 bool URangedWeaponComponent::IsWeaponAbleToFire()
 {
-	if (AimingComponent && AmmoComponent) return AimingComponent->GetIsAiming() && bIsFireRatePassed && AmmoComponent->IsAmmoEnough();
-	return bIsFireRatePassed;
+	if (!FireScheduler.IsReady(GetWorld()->GetTimeSeconds())) return false;
+	return IsShooterAbleToFire();
+}
+
+bool URangedWeaponComponent::IsShooterAbleToFire()
+{
+	if (AimingComponent && AmmoComponent) return AimingComponent->GetIsAiming() && AmmoComponent->IsAmmoEnough();
+	return true;
+}
+
+bool URangedWeaponComponent::IsAutomaticFireHeld() const
+{
+	switch (CurrentWeapon->Trigger)
+	{
+	case ETriggerMechanism::AutomaticTrigger:
+		return bIsTriggerPressed;
+
+	case ETriggerMechanism::OnePressAutoTrigger:
+		return bOnePressToggle;
+
+	default:
+		return false;
+	}
 }
 
 void URangedWeaponComponent::FireAutomaticTriggerOnePress()
@@ -200,59 +482,87 @@ void URangedWeaponComponent::FireAutomaticTriggerOnePress()
 
 void URangedWeaponComponent::FireHold()
 {
+	HoldTrigger.Press(GetWorld()->GetTimeSeconds());
+	bMaxHoldIsReach = false;
+
 	GetOwner()->GetWorldTimerManager().ClearTimer(TimerOfHoldTrigger);
-	GetOwner()->GetWorldTimerManager().SetTimer(TimerOfHoldTrigger, this, &URangedWeaponComponent::CountHoldTriggerTime, HoldTimeRateCount, true);
+
+	if (MaxFireHoldTime > 0.0f)
+	{
+		GetOwner()->GetWorldTimerManager().SetTimer(TimerOfHoldTrigger, this, &URangedWeaponComponent::ReachMaxHoldTime, MaxFireHoldTime, false);
+	}
+	else
+	{
+		ReachMaxHoldTime();
+	}
 }
 
-void URangedWeaponComponent::CountHoldTriggerTime()
+void URangedWeaponComponent::ReachMaxHoldTime()
 {
-	HoldTime += HoldTimeRateCount;
+	if (!HoldTrigger.IsHolding() || bMaxHoldIsReach) return;
 
-	if (!bMaxHoldIsReach)
-	{
-		if (HoldTime >= MaxFireHoldTime)
-		{
-			bMaxHoldIsReach = true;
-			OnJustReachMaxHoldTrigger.Broadcast(this, HoldTime, MaxFireHoldTime);
-		}
-	}
+	bMaxHoldIsReach = true;
+	OnJustReachMaxHoldTrigger.Broadcast(this, GetHoldTime(), MaxFireHoldTime);
 }
 
 void URangedWeaponComponent::FireReleaseAfterHold()
 {
+	if (!HoldTrigger.IsHolding()) return;
+
 	GetOwner()->GetWorldTimerManager().ClearTimer(TimerOfHoldTrigger);
+
+	const float holdTime = HoldTrigger.Release(GetWorld()->GetTimeSeconds());
+
+	// released the same frame the timer was due, before it ran
+	if (holdTime >= MaxFireHoldTime) bMaxHoldIsReach = true;
+
 	if (bMaxHoldIsReach)
 	{
 		FireStandardTrigger();
-		OnMaxFireHoldRelease.Broadcast(this, HoldTime, MaxFireHoldTime);
+		OnMaxFireHoldRelease.Broadcast(this, holdTime, MaxFireHoldTime);
 	}
-	else if (HoldTime >= CurrentWeapon.FireRateAndOther[0])
+	else if (holdTime >= CurrentWeapon->FireRate)
 	{
 		FireStandardTrigger();
 	}
 
 	bMaxHoldIsReach = false;
-	HoldTime = 0.0f;
 }
 
 void URangedWeaponComponent::FireStandardTrigger()
 {
-	TimerFireRateStart();
+	FireScheduler.FireNow(GetWorld()->GetTimeSeconds(), GetFireInterval());
+
+	FireRound(0.0f);
+}
+
+void URangedWeaponComponent::FireRound(const float TimeOffset)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPS_FireRound);
+	CONDITIONAL_SCOPE_CYCLE_COUNTER(STAT_TPS_FirstShotAfterSwitch, bIsFirstShotAfterSwitch);
+	bIsFirstShotAfterSwitch = false;
+
+	RoundTimeOffset = TimeOffset;
 
 	OnFire.Broadcast(this);
 
-	switch (CurrentWeapon.WeaponCost)
+	// fired before its bundle arrived, wait for it rather than firing without FX
+	if (!CurrentWeapon->Projectile.bAssetsResolved) FProjectileAssetStreamer::LoadSynchronous(CurrentWeapon->Projectile);
+
+	PlayFireSound();
+
+	switch (CurrentWeapon->WeaponCost)
 	{
 	case EWeaponCost::Nothing:
 		FireProjectile();
 		break;
 
 	case EWeaponCost::Ammo:
-		FireProjectile(CurrentWeapon.AmmoType);
+		FireProjectile(CurrentWeapon->AmmoType);
 		break;
 
 	case EWeaponCost::Energy:
-		FireProjectile(CurrentWeapon.EnergyType);
+		FireProjectile(CurrentWeapon->EnergyType);
 		break;
 
 	default:
@@ -340,19 +650,17 @@ void URangedWeaponComponent::FireProjectile(const EEnergyType EnergyType)
 
 void URangedWeaponComponent::FireProjectile()
 {
-	TArray<FName> MuzzleName = CurrentWeapon.SocketName;
-	int MuzzleCount = MuzzleName.Num();
+	int MuzzleCount = CurrentWeapon->MuzzleCount;
 
 	for (int i = 0; i < MuzzleCount; i++)
 	{
-		SpawnProjectile(WeaponInWorld, MuzzleName, GetWorld(), i);
+		SpawnProjectile(GetMuzzleTransform(i));
 	}
 }
 
 void URangedWeaponComponent::FireProjectile(int* Ammo)
 {
-	TArray<FName> MuzzleName = CurrentWeapon.SocketName;
-	int32 MuzzleCount = MuzzleName.Num();
+	int32 MuzzleCount = CurrentWeapon->MuzzleCount;
 	int32 CurrentAmmo = *Ammo;
 
 	for (int i = 0; i < MuzzleCount; i++)
@@ -363,19 +671,18 @@ void URangedWeaponComponent::FireProjectile(int* Ammo)
 		}
 
 		CurrentAmmo--;
-		SpawnProjectile(WeaponInWorld, MuzzleName, GetWorld(), i);
+		SpawnProjectile(GetMuzzleTransform(i));
 	}
 	*Ammo = CurrentAmmo;
 }
 
 void URangedWeaponComponent::FireProjectile(float* MyEnergy)
 {
-	TArray<FName> MuzzleName = CurrentWeapon.SocketName;
-	int32 MuzzleCount = MuzzleName.Num();
+	int32 MuzzleCount = CurrentWeapon->MuzzleCount;
 	float CurrentEnergy = *MyEnergy;
-	float EnergyCostPerShot = CurrentWeapon.EnergyUsePerShot;
+	float EnergyCostPerShot = CurrentWeapon->EnergyUsePerShot;
 
-	if (CurrentWeapon.EnergyType != EEnergyType::Overheat)
+	if (CurrentWeapon->EnergyType != EEnergyType::Overheat)
 	{
 		for (int i = 0; i < MuzzleCount; i++)
 		{
@@ -385,7 +692,7 @@ void URangedWeaponComponent::FireProjectile(float* MyEnergy)
 				break;
 			}
 			CurrentEnergy -= EnergyCostPerShot;
-			SpawnProjectile(WeaponInWorld, MuzzleName, GetWorld(), i);
+			SpawnProjectile(GetMuzzleTransform(i));
 		}
 	}
 	else
@@ -399,65 +706,217 @@ void URangedWeaponComponent::FireProjectile(float* MyEnergy)
 			}
 
 			CurrentEnergy += EnergyCostPerShot;
-			SpawnProjectile(WeaponInWorld, MuzzleName, GetWorld(), i);
+			SpawnProjectile(GetMuzzleTransform(i));
 		}
 	}
 	*MyEnergy = CurrentEnergy;
 }
 
-void URangedWeaponComponent::SpawnProjectile(USceneComponent* MyWeaponInWorld, TArray<FName> MuzzleName, UWorld* MyWorld, int32 i)
+void URangedWeaponComponent::SpawnProjectile(const FTransform& MuzzleTransform)
 {
-	FTransform MuzzleTransform = MyWeaponInWorld->GetSocketTransform(MuzzleName[i]);
-	FTransform SpawnTransform = FTransform(GetNewMuzzleRotationFromLineTrace(MuzzleTransform), MuzzleTransform.GetLocation(), MuzzleTransform.GetScale3D());
-
-	ATPS_Projectile* MyProjectile = MyWorld->SpawnActorDeferred<ATPS_Projectile>(ATPS_Projectile::StaticClass(), SpawnTransform);
+	const FTransform SpawnTransform = FTransform(GetNewMuzzleRotationFromLineTrace(MuzzleTransform), MuzzleTransform.GetLocation(), MuzzleTransform.GetScale3D());
 
 	APawn* instigator = Cast<APawn>(GetOwner());
 
-	MyProjectile->SetUpProjectile(CurrentProjectile, instigator);
-	MyProjectile->FinishSpawning(SpawnTransform);
+	if (ProjectileSimulation)
+	ProjectileSimulation->AddProjectile(CurrentWeapon->Projectile, instigator, SpawnTransform, RoundTimeOffset);
 }
 
-void URangedWeaponComponent::TimerFireRateStart()
+void URangedWeaponComponent::FireDueRounds()
 {
-	bIsFireRatePassed = false;
+	const float now = GetWorld()->GetTimeSeconds();
 
-	GetOwner()->GetWorldTimerManager().ClearTimer(FireRateTimer);
-	GetOwner()->GetWorldTimerManager().SetTimer(FireRateTimer, this, &URangedWeaponComponent::TimerFireRateReset, CurrentWeapon.FireRateAndOther[0]);
-}
+	if (!IsAutomaticFireHeld())
+	{
+		StopAutomaticFire();
+		return;
+	}
 
-void URangedWeaponComponent::TimerFireRateReset()
-{
-	bIsFireRatePassed = true;
-	GetOwner()->GetWorldTimerManager().ClearTimer(FireRateTimer);
+	if (!FireScheduler.IsReady(now)) return;
 
-	if (CurrentWeapon.Trigger == ETriggerMechanism::AutomaticTrigger)
+	// same as the old fire rate timer, automatic fire stop until the next press
+	if (!IsShooterAbleToFire())
 	{
-		FireAutomaticTrigger();
+		StopAutomaticFire();
+		return;
 	}
-	else if (CurrentWeapon.Trigger == ETriggerMechanism::OnePressAutoTrigger)
+
+	// every round due since last frame, with its own sub-frame offset, so a high rpm weapon does not lose round at low fps
+	float timeOffsets[FFireScheduler::MaxRoundsPerFrame];
+	const int32 roundCount = FireScheduler.ConsumeDueRounds(now, GetFireInterval(), timeOffsets);
+
+	for (int32 i = 0; i < roundCount; i++)
 	{
-		FireAutomaticTriggerOnePress();
+		if (i > 0 && !IsShooterAbleToFire()) break;
+
+		FireRound(timeOffsets[i]);
 	}
 }
 
-FRotator URangedWeaponComponent::GetNewMuzzleRotationFromLineTrace(FTransform SocketTransform)
+void URangedWeaponComponent::StartSpin(const bool bInSpinUp)
 {
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(GetOwner());
+	if (bInSpinUp == bIsSpinningUp) return;
 
-	FHitResult HitTrace;
+	SpinAlphaAtChange = GetSpinAlpha();
+	SpinChangeTime = GetWorld()->GetTimeSeconds();
+	bIsSpinningUp = bInSpinUp;
+}
+
+float URangedWeaponComponent::GetFireInterval() const
+{
+	return CurrentWeapon->GetFireInterval(GetSpinAlpha());
+}
+
+const FVector& URangedWeaponComponent::GetAimTargetLocation()
+{
+	if (AimTargetFrame == GFrameCounter)
+	{
+		INC_DWORD_STAT(STAT_TPS_AimTraceCacheHit);
+		return AimTargetLocation;
+	}
+
+	AimTargetFrame = GFrameCounter;
+
+	UWorld* world = GetWorld();
 	FVector StartTrace = CameraComponent->GetComponentLocation();
 	FRotator CameraRotation = CameraComponent->GetComponentRotation();
 	FVector LookDirection = UKismetMathLibrary::GetForwardVector(CameraRotation);
-	FVector EndTrace = StartTrace + LookDirection * 100.0f * 3000.0f;
-	FVector TargetLocation;
-	FRotator MuzzleLookRotation;
+	FVector EndTrace = StartTrace + LookDirection * AimTraceDistance;
 
-	if (GetOwner()->GetWorld()->LineTraceSingleByChannel(HitTrace, StartTrace, EndTrace, ECC_Visibility, QueryParams))
+	if (bUseAsyncAimTrace)
 	{
-		TargetLocation = HitTrace.Location;
-		MuzzleLookRotation = UKismetMathLibrary::FindLookAtRotation(SocketTransform.GetLocation(), TargetLocation);
+		// trace data is only kept one frame, a handle from an older frame is not ready
+		FTraceDatum traceDatum;
+		const bool bHasLastFrameTrace = AimTraceHandle.IsValid() && world->QueryTraceData(AimTraceHandle, traceDatum);
+
+		AimTraceHandle = world->AsyncLineTraceByChannel(EAsyncTraceType::Single, StartTrace, EndTrace, ECC_Visibility, AimQueryParams);
+		INC_DWORD_STAT(STAT_TPS_AimTraceAsync);
+
+		if (bHasLastFrameTrace)
+		{
+			const FHitResult* hit = FHitResult::GetFirstBlockingHit(traceDatum.OutHits);
+			AimTargetLocation = hit ? hit->Location : traceDatum.End;
+			return AimTargetLocation;
+		}
+	}
+
+	FHitResult HitTrace;
+	INC_DWORD_STAT(STAT_TPS_AimTraceSync);
+
+	// nothing hit, aim at the end of the trace instead of the world origin
+	AimTargetLocation = world->LineTraceSingleByChannel(HitTrace, StartTrace, EndTrace, ECC_Visibility, AimQueryParams)
+		? HitTrace.Location : EndTrace;
+
+	return AimTargetLocation;
+}
+
+FRotator URangedWeaponComponent::GetNewMuzzleRotationFromLineTrace(const FTransform& SocketTransform)
+{
+	return UKismetMathLibrary::FindLookAtRotation(SocketTransform.GetLocation(), GetAimTargetLocation());
+}
+
+void URangedWeaponComponent::StopAutomaticFire()
+{
+	SetComponentTickEnabled(false);
+	StopFireLoop();
+}
+
+//======================
+// Fire audio (private):
+//======================
+
+bool URangedWeaponComponent::IsFireLoopWeapon() const
+{
+	if (CurrentWeapon->Projectile.FireLoopSound == nullptr) return false;
+
+	return CurrentWeapon->Trigger == ETriggerMechanism::AutomaticTrigger || CurrentWeapon->Trigger == ETriggerMechanism::OnePressAutoTrigger;
+}
+
+void URangedWeaponComponent::PlayFireSound()
+{
+	const FProjectileSpec& projectile = CurrentWeapon->Projectile;
+
+	if (IsFireLoopWeapon())
+	{
+		// started by the first round of a burst, the next rounds are already heard
+		if (FireLoopVoice && FireLoopVoice->IsPlaying()) return;
+
+		if (FireLoopVoice == nullptr)
+		{
+			FireLoopVoice = SpawnFireVoice(projectile.FireLoopSound);
+			return;
+		}
+
+		FireLoopVoice->SetSound(projectile.FireLoopSound);
+		FireLoopVoice->Play();
+		INC_DWORD_STAT(STAT_TPS_FireVoicePlay);
+		return;
+	}
+
+	if (projectile.MuzzleSound == nullptr) return;
+
+	// the weapon budget, the oldest voice is cut instead of adding one more
+	if (NextMuzzleVoice >= projectile.MaxMuzzleVoice) NextMuzzleVoice = 0;
+
+	UAudioComponent* muzzleVoice = MuzzleVoices.IsValidIndex(NextMuzzleVoice) ? MuzzleVoices[NextMuzzleVoice] : nullptr;
+
+	if (muzzleVoice)
+	{
+		if (muzzleVoice->IsPlaying()) INC_DWORD_STAT(STAT_TPS_FireVoiceSteal);
+
+		muzzleVoice->SetSound(projectile.MuzzleSound);
+		muzzleVoice->Play();
+		INC_DWORD_STAT(STAT_TPS_FireVoicePlay);
+	}
+	else
+	{
+		muzzleVoice = SpawnFireVoice(projectile.MuzzleSound);
+
+		if (MuzzleVoices.IsValidIndex(NextMuzzleVoice)) MuzzleVoices[NextMuzzleVoice] = muzzleVoice;
+		else MuzzleVoices.Add(muzzleVoice);
 	}
-	return MuzzleLookRotation;
+
+	NextMuzzleVoice++;
+}
+
+void URangedWeaponComponent::StopFireLoop()
+{
+	if (FireLoopVoice == nullptr || !FireLoopVoice->IsPlaying()) return;
+
+	FireLoopVoice->Stop();
+
+	USoundBase* tailSound = CurrentWeapon->Projectile.FireTailSound;
+	if (tailSound == nullptr) return;
+
+	if (FireTailVoice == nullptr)
+	{
+		FireTailVoice = SpawnFireVoice(tailSound);
+		return;
+	}
+
+	FireTailVoice->SetSound(tailSound);
+	FireTailVoice->Play();
+	INC_DWORD_STAT(STAT_TPS_FireVoicePlay);
+}
+
+void URangedWeaponComponent::OnProjectileAssetsReleased(const TSet<UObject*>& ReleasedObjects)
+{
+	for (UAudioComponent* voice : { FireLoopVoice, FireTailVoice })
+	{
+		if (voice && ReleasedObjects.Contains(voice->Sound)) voice->SetSound(nullptr);
+	}
+
+	for (UAudioComponent* muzzleVoice : MuzzleVoices)
+	{
+		if (muzzleVoice && ReleasedObjects.Contains(muzzleVoice->Sound)) muzzleVoice->SetSound(nullptr);
+	}
+}
+
+UAudioComponent* URangedWeaponComponent::SpawnFireVoice(USoundBase* Sound)
+{
+	INC_DWORD_STAT(STAT_TPS_FireVoicePlay);
+
+	// not auto destroyed, the voice is played again by the next round
+	return UGameplayStatics::SpawnSoundAttached(Sound, WeaponInWorld, NAME_None, FVector::ZeroVector, EAttachLocation::KeepRelativeOffset,
+		false, 1.0f, 1.0f, 0.0f, nullptr, nullptr, false);
 }
@@ -0,0 +1,79 @@
+#include "Custom/TPSStats.h"
+
+//=================
+// Projectile Pool:
+//=================
+
+DEFINE_STAT(STAT_TPS_ProjectilePoolSize);
+DEFINE_STAT(STAT_TPS_ProjectilePoolInUse);
+DEFINE_STAT(STAT_TPS_ProjectilePoolHighWater);
+DEFINE_STAT(STAT_TPS_ProjectilePoolMiss);
+
+//=======================
+// Projectile Simulation:
+//=======================
+
+DEFINE_STAT(STAT_TPS_ProjectileSimulation);
+DEFINE_STAT(STAT_TPS_ProjectileIntegrate);
+DEFINE_STAT(STAT_TPS_ProjectileCollision);
+DEFINE_STAT(STAT_TPS_ProjectileVisual);
+DEFINE_STAT(STAT_TPS_ProjectileLiveCount);
+DEFINE_STAT(STAT_TPS_ProjectileVisualCount);
+DEFINE_STAT(STAT_TPS_ProjectileTrail);
+DEFINE_STAT(STAT_TPS_ProjectileSyncSweep);
+DEFINE_STAT(STAT_TPS_ProjectileAsyncSweep);
+DEFINE_STAT(STAT_TPS_ProjectileAsyncSweepLate);
+DEFINE_STAT(STAT_TPS_ProjectileHitscan);
+DEFINE_STAT(STAT_TPS_ProjectileHitscanCount);
+DEFINE_STAT(STAT_TPS_ProjectileSignificance);
+DEFINE_STAT(STAT_TPS_ProjectileNear);
+DEFINE_STAT(STAT_TPS_ProjectileMid);
+DEFINE_STAT(STAT_TPS_ProjectileFar);
+DEFINE_STAT(STAT_TPS_ProjectileHidden);
+DEFINE_STAT(STAT_TPS_ProjectilePeakCount);
+DEFINE_STAT(STAT_TPS_ProjectileExpired);
+DEFINE_STAT(STAT_TPS_ProjectileOutOfWorld);
+
+//============
+// FX Manager:
+//============
+
+DEFINE_STAT(STAT_TPS_FXPoolSize);
+DEFINE_STAT(STAT_TPS_FXLive);
+DEFINE_STAT(STAT_TPS_FXPoolHit);
+DEFINE_STAT(STAT_TPS_FXPoolMiss);
+DEFINE_STAT(STAT_TPS_FXCulled);
+DEFINE_STAT(STAT_TPS_FXImpactMerged);
+
+//==================
+// Asset Streaming:
+//==================
+
+DEFINE_STAT(STAT_TPS_AssetAsyncRequest);
+DEFINE_STAT(STAT_TPS_AssetSyncFallback);
+DEFINE_STAT(STAT_TPS_AssetSyncLoad);
+DEFINE_STAT(STAT_TPS_AssetRelease);
+
+//========
+// Aiming:
+//========
+
+DEFINE_STAT(STAT_TPS_AimingBeginPlay);
+DEFINE_STAT(STAT_TPS_AimingProfileBuild);
+DEFINE_STAT(STAT_TPS_AimingTick);
+
+//===============
+// Ranged Weapon:
+//===============
+
+DEFINE_STAT(STAT_TPS_WeaponSwitch);
+DEFINE_STAT(STAT_TPS_AimTraceSync);
+DEFINE_STAT(STAT_TPS_AimTraceAsync);
+DEFINE_STAT(STAT_TPS_AimTraceCacheHit);
+DEFINE_STAT(STAT_TPS_MuzzleTransform);
+DEFINE_STAT(STAT_TPS_FireVoicePlay);
+DEFINE_STAT(STAT_TPS_FireVoiceSteal);
+DEFINE_STAT(STAT_TPS_WeaponPrewarm);
+DEFINE_STAT(STAT_TPS_WeaponPrewarmCount);
+DEFINE_STAT(STAT_TPS_FireRound);
+DEFINE_STAT(STAT_TPS_FirstShotAfterSwitch);
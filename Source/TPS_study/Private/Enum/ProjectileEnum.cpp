@@ -0,0 +1 @@
+#include "Enum/ProjectileEnum.h"
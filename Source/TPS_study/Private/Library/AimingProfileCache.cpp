@@ -0,0 +1,61 @@
+#include "Library/AimingProfileCache.h"
+#include "Engine/DataTable.h"
+
+#include "Custom/TPSStats.h"
+#include "Library/SharedTableCache.h"
+
+namespace AimingProfileCache
+{
+	static TSharedTableCache<TWeakObjectPtr<const UDataTable>, FAimingProfileTable> CachedTables;
+
+	static void BuildAimingProfileTable(const UDataTable* AimingTable, FAimingProfileTable& OutProfileTable)
+	{
+		static const FString contextString(TEXT("Aiming Profile Cache"));
+
+		OutProfileTable.AimingNames = AimingTable->GetRowNames();
+		OutProfileTable.AimStats.SetNum(OutProfileTable.AimingNames.Num());
+
+		for (int32 i = 0; i < OutProfileTable.AimingNames.Num(); i++)
+		{
+			const FAimingStatCompact* aimStatRow = AimingTable->FindRow<FAimingStatCompact>(OutProfileTable.AimingNames[i], contextString, true);
+			if (aimStatRow) OutProfileTable.AimStats[i] = aimStatRow->AimStat;
+		}
+	}
+
+#if WITH_EDITOR
+	static void MarkStale(const UObject* ChangedTable)
+	{
+		CachedTables.MarkStale([ChangedTable](const TWeakObjectPtr<const UDataTable>& TableKey) { return TableKey.Get() == ChangedTable; });
+	}
+#endif
+}
+
+//===========================================================================
+// public function:
+//===========================================================================
+
+const FAimingProfileTable* FAimingProfileCache::GetAimingProfiles(const UDataTable* AimingTable)
+{
+	using namespace AimingProfileCache;
+
+	check(IsInGameThread());
+
+	if (AimingTable == nullptr) return nullptr;
+
+	const TWeakObjectPtr<const UDataTable> tableKey(AimingTable);
+	if (const FAimingProfileTable* profileTable = CachedTables.Find(tableKey)) return profileTable;
+
+	SCOPE_CYCLE_COUNTER(STAT_TPS_AimingProfileBuild);
+
+	bool bIsNewKey;
+	FAimingProfileTable& profileTable = CachedTables.Add(tableKey, bIsNewKey);
+
+#if WITH_EDITOR
+	// the table can be edited between two play sessions
+	if (bIsNewKey) const_cast<UDataTable*>(AimingTable)->OnDataTableChanged().AddStatic(&AimingProfileCache::MarkStale, (const UObject*)AimingTable);
+#endif
+
+	BuildAimingProfileTable(AimingTable, profileTable);
+
+	return &profileTable;
+}
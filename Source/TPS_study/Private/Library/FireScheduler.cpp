@@ -0,0 +1,33 @@
+#include "Library/FireScheduler.h"
+
+void FFireScheduler::FireNow(const float Now, const float FireInterval)
+{
+	NextFireTime = Now + FireInterval;
+}
+
+int32 FFireScheduler::ConsumeDueRounds(const float Now, const float FireInterval, float* OutTimeOffsets)
+{
+	// a zero interval would never catch up with Now
+	const float fireInterval = FMath::Max(FireInterval, KINDA_SMALL_NUMBER);
+
+	int32 roundCount = 0;
+
+	while (NextFireTime <= Now && roundCount < MaxRoundsPerFrame)
+	{
+		OutTimeOffsets[roundCount] = Now - NextFireTime;
+		NextFireTime += fireInterval;
+		roundCount++;
+	}
+
+	if (NextFireTime <= Now)
+	{
+		NextFireTime = Now + fireInterval;
+	}
+
+	return roundCount;
+}
+
+void FFireScheduler::Reset()
+{
+	NextFireTime = 0.0f;
+}
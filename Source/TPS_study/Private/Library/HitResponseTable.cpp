@@ -0,0 +1,150 @@
+#include "Library/HitResponseTable.h"
+#include "Components/PrimitiveComponent.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "Custom/CustomCollisionChannel.h"
+#include "Custom/CustomPhysicalSurface.h"
+#include "DataAsset/ProjectileParticleDataAsset.h"
+#include "DataAsset/ProjectileSoundDataAsset.h"
+
+namespace HitResponseCache
+{
+	/** particle asset, sound asset */
+	typedef TPair<TWeakObjectPtr<const UProjectileParticleDataAsset>, TWeakObjectPtr<const UProjectileSoundDataAsset>> FCachedTableKey;
+
+	static TMap<FCachedTableKey, TSharedPtr<FHitResponseTable>> CachedTables;
+
+	static UParticleSystem* GetHitParticle(const UProjectileParticleDataAsset* ParticleObject, const EHitResponse InResponse)
+	{
+		if (ParticleObject == nullptr) return nullptr;
+
+		const TArray<UParticleSystem*>& hitParticles = ParticleObject->ProjectileParticle.HitParticle;
+		const int32 index = (int32)InResponse;
+
+		return hitParticles.IsValidIndex(index) ? hitParticles[index] : nullptr;
+	}
+
+#if WITH_EDITOR
+	/** rebuilt in place, so FProjectileSpec already pointing to the table see the change */
+	static void OnObjectPropertyChanged(UObject* ChangedObject, FPropertyChangedEvent& PropertyChangedEvent)
+	{
+		for (TPair<FCachedTableKey, TSharedPtr<FHitResponseTable>>& cachedTable : CachedTables)
+		{
+			const UProjectileParticleDataAsset* particleObject = cachedTable.Key.Key.Get();
+			const UProjectileSoundDataAsset* soundObject = cachedTable.Key.Value.Get();
+
+			if (particleObject == ChangedObject || soundObject == ChangedObject)
+			{
+				FHitResponseCache::BuildHitResponseTable(particleObject, soundObject, *cachedTable.Value);
+			}
+		}
+	}
+#endif
+}
+
+//===========================================================================
+// public function:
+//===========================================================================
+
+const FHitResponse& FHitResponseTable::Resolve(const FHitResult& Hit) const
+{
+	const UPrimitiveComponent* hitComponent = Hit.Component.Get();
+	const EHitChannel hitChannel = hitComponent ? GetHitChannel(hitComponent->GetCollisionObjectType()) : EHitChannel::World;
+
+	// nullptr physical material give the surface of the default one
+	const EPhysicalSurface surfaceType = UPhysicalMaterial::DetermineSurfaceType(Hit.PhysMaterial.Get());
+
+	return Responses[(int32)hitChannel][surfaceType];
+}
+
+EHitChannel FHitResponseTable::GetHitChannel(const ECollisionChannel ObjectType)
+{
+	if (ObjectType == ECC_Player) return EHitChannel::Player;
+	if (ObjectType == ECC_Enemy) return EHitChannel::Enemy;
+	return EHitChannel::World;
+}
+
+EHitResponse FHitResponseTable::GetHitResponse(const EHitChannel HitChannel, const EPhysicalSurface SurfaceType)
+{
+	if (HitChannel != EHitChannel::World) return EHitResponse::Character;
+	if (SurfaceType == SurfaceType_Water) return EHitResponse::Water;
+	return EHitResponse::World;
+}
+
+TSharedPtr<const FHitResponseTable> FHitResponseCache::GetHitResponses(const UProjectileParticleDataAsset* ParticleObject, const UProjectileSoundDataAsset* SoundObject)
+{
+	using namespace HitResponseCache;
+
+	check(IsInGameThread());
+
+	const FCachedTableKey tableKey(ParticleObject, SoundObject);
+
+	if (const TSharedPtr<FHitResponseTable>* cachedTable = CachedTables.Find(tableKey))
+	{
+		return *cachedTable;
+	}
+
+#if WITH_EDITOR
+	// the data assets can be edited between two play sessions
+	if (CachedTables.Num() == 0)
+	{
+		FCoreUObjectDelegates::OnObjectPropertyChanged.AddStatic(&HitResponseCache::OnObjectPropertyChanged);
+	}
+#endif
+
+	TSharedPtr<FHitResponseTable>& newTable = CachedTables.Add(tableKey, MakeShared<FHitResponseTable>());
+	BuildHitResponseTable(ParticleObject, SoundObject, *newTable);
+
+	return newTable;
+}
+
+void FHitResponseCache::EvictHitResponses(const UProjectileParticleDataAsset* ParticleObject, const UProjectileSoundDataAsset* SoundObject)
+{
+	check(IsInGameThread());
+
+	// the empty table is shared by every unloaded spec
+	if (ParticleObject == nullptr && SoundObject == nullptr) return;
+
+	HitResponseCache::CachedTables.Remove(HitResponseCache::FCachedTableKey(ParticleObject, SoundObject));
+}
+
+void FHitResponseCache::BuildHitResponseTable(const UProjectileParticleDataAsset* ParticleObject, const UProjectileSoundDataAsset* SoundObject, FHitResponseTable& OutTable)
+{
+	using namespace HitResponseCache;
+
+	USoundBase* hitSound = nullptr;
+
+	if (SoundObject)
+	{
+		const TArray<USoundBase*>& hitSounds = SoundObject->ProjectileSound.HitAndTrailSound;
+		if (hitSounds.Num() > 0) hitSound = hitSounds[0];
+	}
+
+	FHitResponse responses[(int32)EHitResponse::Max];
+
+	for (int32 i = 0; i < (int32)EHitResponse::Max; i++)
+	{
+		responses[i].Particle = GetHitParticle(ParticleObject, (EHitResponse)i);
+		responses[i].Sound = hitSound;
+	}
+
+	// an asset with only HitWorld still play it on character and water
+	for (int32 i = (int32)EHitResponse::Character; i <= (int32)EHitResponse::Water; i++)
+	{
+		if (!responses[i].Particle.IsValid()) responses[i].Particle = responses[(int32)EHitResponse::World].Particle;
+	}
+
+	for (int32 channel = 0; channel < (int32)EHitChannel::Max; channel++)
+	{
+		for (int32 surface = 0; surface < SurfaceType_Max; surface++)
+		{
+			const EHitResponse hitResponse = FHitResponseTable::GetHitResponse((EHitChannel)channel, (EPhysicalSurface)surface);
+			OutTable.Responses[channel][surface] = responses[(int32)hitResponse];
+		}
+	}
+
+	// nothing was hit, so no hit sound
+	OutTable.NoHitResponse.Particle = responses[(int32)EHitResponse::NoHit].Particle;
+	OutTable.NoHitResponse.Sound = nullptr;
+}
@@ -0,0 +1,34 @@
+#include "Library/HoldTrigger.h"
+
+void FHoldTrigger::Press(const float Now)
+{
+	bIsHolding = true;
+	HoldStartTime = Now;
+}
+
+float FHoldTrigger::Release(const float Now)
+{
+	const float holdTime = GetHoldTime(Now);
+	bIsHolding = false;
+
+	return holdTime;
+}
+
+float FHoldTrigger::GetHoldTime(const float Now) const
+{
+	return bIsHolding ? FMath::Max(Now - HoldStartTime, 0.0f) : 0.0f;
+}
+
+float FHoldTrigger::GetChargeFraction(const float Now, const float MaxHoldTime) const
+{
+	if (!bIsHolding) return 0.0f;
+	if (MaxHoldTime <= 0.0f) return 1.0f;
+
+	return FMath::Clamp(GetHoldTime(Now) / MaxHoldTime, 0.0f, 1.0f);
+}
+
+void FHoldTrigger::Reset()
+{
+	bIsHolding = false;
+	HoldStartTime = 0.0f;
+}
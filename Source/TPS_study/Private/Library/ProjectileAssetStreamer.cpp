@@ -0,0 +1,318 @@
+#include "Library/ProjectileAssetStreamer.h"
+#include "Engine/StreamableManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Particles/ParticleSystem.h"
+#include "Sound/SoundCue.h"
+#include "Sound/SoundNodeWavePlayer.h"
+#include "Sound/SoundWave.h"
+
+#include "Custom/TPSStats.h"
+#include "DataAsset/ProjectileParticleDataAsset.h"
+#include "DataAsset/ProjectileSoundDataAsset.h"
+#include "Library/HitResponseTable.h"
+#include "Library/WeaponSpecCache.h"
+
+namespace ProjectileAssetStreamer
+{
+	struct FBundle
+	{
+		/** nullptr while the bundle is not requested (owned but never equipped) or released */
+		TSharedPtr<FStreamableHandle> Handle;
+		int32 OwnerCount = 0;
+	};
+
+	static FStreamableManager StreamableManager;
+
+	/** a spec is never freed (see FWeaponSpecCache), the pointer is a stable key */
+	static TMap<const FProjectileSpec*, FBundle> Bundles;
+
+	static FAutoConsoleCommandWithOutputDevice MemReportCommand(
+		TEXT("TPS.Weapon.MemReport"),
+		TEXT("list the projectile FX and sound bundles of the weapons, their owner count and resident bytes"),
+		FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&FProjectileAssetStreamer::DumpResidentAssets));
+
+	static void GetAssetPaths(const FProjectileSpec& MySpec, TArray<FSoftObjectPath>& OutPaths)
+	{
+		if (!MySpec.ParticleAsset.IsNull()) OutPaths.Add(MySpec.ParticleAsset.ToSoftObjectPath());
+		if (!MySpec.SoundAsset.IsNull()) OutPaths.Add(MySpec.SoundAsset.ToSoftObjectPath());
+	}
+
+	static void Resolve(const FProjectileSpec* MySpec)
+	{
+		// the spec is shared read only, its asset fields are only written here and by BuildWeaponSpec
+		if (!MySpec->bAssetsResolved) FWeaponSpecCache::ResolveProjectileAssets(const_cast<FProjectileSpec&>(*MySpec));
+	}
+
+	static void OnBundleLoaded(const FProjectileSpec* MySpec)
+	{
+		// dropped by its last owner while it was loading
+		if (!Bundles.Contains(MySpec)) return;
+
+		Resolve(MySpec);
+		FProjectileAssetStreamer::OnAssetsLoaded.Broadcast(*MySpec);
+	}
+
+	static void AddSound(USoundBase* Sound, TSet<UObject*>& OutObjects)
+	{
+		if (Sound == nullptr) return;
+
+		OutObjects.Add(Sound);
+
+		// a cue is small, the waves it play are the memory
+		// RecursiveFindNode is not const
+		if (USoundCue* soundCue = Cast<USoundCue>(Sound))
+		{
+			TArray<USoundNodeWavePlayer*> wavePlayers;
+			soundCue->RecursiveFindNode<USoundNodeWavePlayer>(soundCue->FirstNode, wavePlayers);
+
+			for (const USoundNodeWavePlayer* wavePlayer : wavePlayers)
+			{
+				if (USoundWave* soundWave = wavePlayer->GetSoundWave()) OutObjects.Add(soundWave);
+			}
+		}
+	}
+
+	static void GetSoundObjects(const UProjectileSoundDataAsset* SoundObject, TSet<UObject*>& OutObjects)
+	{
+		if (SoundObject == nullptr) return;
+
+		const FProjectileSound& sound = SoundObject->ProjectileSound;
+
+		AddSound(sound.MuzzleSound, OutObjects);
+		AddSound(sound.FireLoopSound, OutObjects);
+		for (USoundBase* hitAndTrailSound : sound.HitAndTrailSound) AddSound(hitAndTrailSound, OutObjects);
+	}
+
+	static void GetParticleObjects(const UProjectileParticleDataAsset* ParticleObject, TSet<UObject*>& OutObjects)
+	{
+		if (ParticleObject == nullptr) return;
+
+		const FProjectileParticle& particle = ParticleObject->ProjectileParticle;
+
+		for (const TArray<UParticleSystem*>* particleArray : { &particle.MuzzleParticle, &particle.TrailParticle, &particle.HitParticle, &particle.OtherParticle })
+		{
+			for (UParticleSystem* particleSystem : *particleArray)
+			{
+				if (particleSystem) OutObjects.Add(particleSystem);
+			}
+		}
+	}
+
+	static bool IsLoaded(const FBundle& Bundle)
+	{
+		return Bundle.Handle.IsValid() && Bundle.Handle->HasLoadCompleted();
+	}
+
+	/**
+	 * particle, cue and wave of the data asset the bundle handle hold, nothing while it is loading
+	 * not the soft pointer of the spec: an asset loaded by someone else is not this bundle's to release
+	 */
+	static void GetHeldObjects(const FBundle& Bundle, TSet<UObject*>& OutObjects)
+	{
+		if (!IsLoaded(Bundle)) return;
+
+		TArray<UObject*> loadedAssets;
+		Bundle.Handle->GetLoadedAssets(loadedAssets);
+
+		for (const UObject* loadedAsset : loadedAssets)
+		{
+			GetParticleObjects(Cast<UProjectileParticleDataAsset>(loadedAsset), OutObjects);
+			GetSoundObjects(Cast<UProjectileSoundDataAsset>(loadedAsset), OutObjects);
+		}
+	}
+
+	static SIZE_T SumResourceBytes(const TSet<UObject*>& Objects)
+	{
+		SIZE_T residentBytes = 0;
+		for (UObject* object : Objects)
+		{
+			residentBytes += object->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		}
+		return residentBytes;
+	}
+}
+
+//===========================================================================
+// public function:
+//===========================================================================
+
+FProjectileAssetStreamer::FOnAssetsReleased FProjectileAssetStreamer::OnAssetsReleased;
+FProjectileAssetStreamer::FOnAssetsLoaded FProjectileAssetStreamer::OnAssetsLoaded;
+
+void FProjectileAssetStreamer::RequestAsyncLoad(const FProjectileSpec& MySpec)
+{
+	using namespace ProjectileAssetStreamer;
+
+	check(IsInGameThread());
+
+	// a bundle only exist between the first AddOwner and the last RemoveOwner, so nothing loaded here is left unreleased
+	FBundle* bundle = Bundles.Find(&MySpec);
+	if (!ensureMsgf(bundle, TEXT("Projectile asset %s / %s requested without owner"), *MySpec.ParticleAsset.ToString(), *MySpec.SoundAsset.ToString())) return;
+
+	// requested already, the handle is what keep the asset alive, not bAssetsResolved
+	if (bundle->Handle.IsValid()) return;
+
+	TArray<FSoftObjectPath> assetPaths;
+	GetAssetPaths(MySpec, assetPaths);
+
+	// no particle and no sound, nothing to hold
+	if (assetPaths.Num() == 0)
+	{
+		Resolve(&MySpec);
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_TPS_AssetAsyncRequest);
+
+	// asset already in memory are held by the handle too, it complete right away
+	bundle->Handle = StreamableManager.RequestAsyncLoad(assetPaths,
+		FStreamableDelegate::CreateStatic(&ProjectileAssetStreamer::OnBundleLoaded, &MySpec), FStreamableManager::AsyncLoadHighPriority, true);
+
+	if (bundle->Handle.IsValid() && bundle->Handle->HasLoadCompleted()) Resolve(&MySpec);
+}
+
+void FProjectileAssetStreamer::LoadSynchronous(const FProjectileSpec& MySpec)
+{
+	using namespace ProjectileAssetStreamer;
+
+	check(IsInGameThread());
+
+	FBundle* bundle = Bundles.Find(&MySpec);
+	if (!ensureMsgf(bundle, TEXT("Projectile asset %s / %s loaded without owner"), *MySpec.ParticleAsset.ToString(), *MySpec.SoundAsset.ToString())) return;
+
+	// held and loaded, at most its completion callback has not run yet
+	if (bundle->Handle.IsValid() && bundle->Handle->HasLoadCompleted())
+	{
+		Resolve(&MySpec);
+		return;
+	}
+
+	TArray<FSoftObjectPath> assetPaths;
+	GetAssetPaths(MySpec, assetPaths);
+
+	if (assetPaths.Num() == 0)
+	{
+		Resolve(&MySpec);
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_TPS_AssetSyncLoad);
+	INC_DWORD_STAT(STAT_TPS_AssetSyncFallback);
+
+	const double startTime = FPlatformTime::Seconds();
+
+	if (bundle->Handle.IsValid())
+	{
+		bundle->Handle->WaitUntilComplete();
+	}
+	else
+	{
+		bundle->Handle = StreamableManager.RequestSyncLoad(assetPaths, true);
+	}
+
+	Resolve(&MySpec);
+
+	// the bundle should have been requested earlier, so this show where
+	UE_LOG(LogTemp, Warning, TEXT("Projectile asset %s / %s loaded on fire in %.2f ms"),
+		*MySpec.ParticleAsset.ToString(), *MySpec.SoundAsset.ToString(), (FPlatformTime::Seconds() - startTime) * 1000.0);
+}
+
+void FProjectileAssetStreamer::AddOwner(const FProjectileSpec& MySpec)
+{
+	check(IsInGameThread());
+
+	ProjectileAssetStreamer::Bundles.FindOrAdd(&MySpec).OwnerCount++;
+}
+
+void FProjectileAssetStreamer::RemoveOwner(const FProjectileSpec& MySpec)
+{
+	using namespace ProjectileAssetStreamer;
+
+	check(IsInGameThread());
+
+	FBundle* bundle = Bundles.Find(&MySpec);
+	if (bundle == nullptr || --bundle->OwnerCount > 0) return;
+
+	// read from the handle before it is released
+	const bool bWasLoaded = IsLoaded(*bundle);
+
+	TSet<UObject*> releasedObjects;
+	GetHeldObjects(*bundle, releasedObjects);
+
+	// projectile still in flight keep their data asset (ATPS_ProjectileSimulation::AddReferencedObjects)
+	if (bundle->Handle.IsValid())
+	{
+		if (bundle->Handle->IsLoadingInProgress()) bundle->Handle->CancelHandle();
+		else bundle->Handle->ReleaseHandle();
+	}
+
+	Bundles.Remove(&MySpec);
+
+	// a particle or sound shared with a bundle still owned stay in the pools
+	if (releasedObjects.Num() > 0)
+	{
+		TSet<UObject*> ownedObjects;
+		for (const TPair<const FProjectileSpec*, FBundle>& ownedBundle : Bundles)
+		{
+			GetHeldObjects(ownedBundle.Value, ownedObjects);
+		}
+
+		releasedObjects = releasedObjects.Difference(ownedObjects);
+	}
+
+	// a spec without asset is resolved without a handle, its hit response is the shared default one
+	if (bWasLoaded && MySpec.bAssetsResolved) FHitResponseCache::EvictHitResponses(MySpec.ParticleObject, MySpec.SoundObject);
+	FWeaponSpecCache::ClearProjectileAssets(const_cast<FProjectileSpec&>(MySpec));
+
+	// pooled FX component and fire voice would keep them loaded
+	if (releasedObjects.Num() > 0) OnAssetsReleased.Broadcast(releasedObjects);
+
+	INC_DWORD_STAT(STAT_TPS_AssetRelease);
+}
+
+void FProjectileAssetStreamer::GetSoundWaves(const FProjectileSpec& MySpec, TArray<USoundWave*>& OutSoundWaves)
+{
+	TSet<UObject*> soundObjects;
+	ProjectileAssetStreamer::GetSoundObjects(MySpec.SoundObject, soundObjects);
+
+	for (UObject* soundObject : soundObjects)
+	{
+		if (USoundWave* soundWave = Cast<USoundWave>(soundObject)) OutSoundWaves.Add(soundWave);
+	}
+}
+
+SIZE_T FProjectileAssetStreamer::GetResidentBytes(const FProjectileSpec& MySpec)
+{
+	using namespace ProjectileAssetStreamer;
+
+	const FBundle* bundle = Bundles.Find(&MySpec);
+	if (bundle == nullptr) return 0;
+
+	TSet<UObject*> residentObjects;
+	GetHeldObjects(*bundle, residentObjects);
+
+	return SumResourceBytes(residentObjects);
+}
+
+void FProjectileAssetStreamer::DumpResidentAssets(FOutputDevice& Ar)
+{
+	using namespace ProjectileAssetStreamer;
+
+	// shared FX are counted once in the total
+	TSet<UObject*> allResidentObjects;
+
+	for (const TPair<const FProjectileSpec*, FBundle>& bundle : Bundles)
+	{
+		TSet<UObject*> residentObjects;
+		GetHeldObjects(bundle.Value, residentObjects);
+		allResidentObjects.Append(residentObjects);
+
+		const TCHAR* loadState = IsLoaded(bundle.Value) ? TEXT("loaded") : (bundle.Value.Handle.IsValid() ? TEXT("loading") : TEXT("not loaded"));
+
+		Ar.Logf(TEXT("%s / %s: owner %i, %s, %.1f KB"),
+			*bundle.Key->ParticleAsset.ToString(), *bundle.Key->SoundAsset.ToString(), bundle.Value.OwnerCount,
+			loadState, SumResourceBytes(residentObjects) / 1024.0f);
+	}
+
+	Ar.Logf(TEXT("weapon bundle %i, resident %.1f KB"), Bundles.Num(), SumResourceBytes(allResidentObjects) / 1024.0f);
+}
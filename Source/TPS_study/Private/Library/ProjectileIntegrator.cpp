@@ -0,0 +1,98 @@
+#include "Library/ProjectileIntegrator.h"
+
+// the scalar path must not fuse a + b * c into one multiply-add, the vector path round the multiply and the add separately
+#if PLATFORM_COMPILER_CLANG
+	#pragma STDC FP_CONTRACT OFF
+#elif defined(_MSC_VER)
+	#pragma fp_contract(off)
+#endif
+
+void FProjectileIntegrator::IntegrateScalar(const FProjectileIntegrationStream& Stream, const float DeltaSeconds)
+{
+	float* RESTRICT positionX = Stream.PositionX;
+	float* RESTRICT positionY = Stream.PositionY;
+	float* RESTRICT positionZ = Stream.PositionZ;
+	const float* RESTRICT velocityX = Stream.VelocityX;
+	const float* RESTRICT velocityY = Stream.VelocityY;
+	float* RESTRICT velocityZ = Stream.VelocityZ;
+	const float* RESTRICT gravityZ = Stream.GravityZ;
+	float* RESTRICT lifeTime = Stream.LifeTime;
+
+	const float halfDeltaSquared = 0.5f * DeltaSeconds * DeltaSeconds;
+
+	for (int32 i = 0; i < Stream.Num; i++)
+	{
+		// one operation per statement, in the order of IntegrateVector
+		const float moveX = velocityX[i] * DeltaSeconds;
+		const float moveY = velocityY[i] * DeltaSeconds;
+		const float moveZ = velocityZ[i] * DeltaSeconds;
+		const float fallZ = gravityZ[i] * halfDeltaSquared;
+		const float accelerationZ = gravityZ[i] * DeltaSeconds;
+
+		const float movedZ = positionZ[i] + moveZ;
+
+		positionX[i] = positionX[i] + moveX;
+		positionY[i] = positionY[i] + moveY;
+		positionZ[i] = movedZ + fallZ;
+		velocityZ[i] = velocityZ[i] + accelerationZ;
+		lifeTime[i] = lifeTime[i] - DeltaSeconds;
+	}
+}
+
+void FProjectileIntegrator::IntegrateVector(const FProjectileIntegrationStream& Stream, const float DeltaSeconds)
+{
+	const float halfDeltaSquared = 0.5f * DeltaSeconds * DeltaSeconds;
+
+	const VectorRegister deltaSeconds = VectorSetFloat1(DeltaSeconds);
+	const VectorRegister halfDeltaSquaredRegister = VectorSetFloat1(halfDeltaSquared);
+
+	const int32 vectorNum = Stream.Num & ~3;
+
+	// VectorMultiplyAdd is fused on some platform, so multiply and add are kept separated
+	for (int32 i = 0; i < vectorNum; i += 4)
+	{
+		const VectorRegister positionX = VectorLoad(Stream.PositionX + i);
+		const VectorRegister positionY = VectorLoad(Stream.PositionY + i);
+		const VectorRegister positionZ = VectorLoad(Stream.PositionZ + i);
+		const VectorRegister velocityX = VectorLoad(Stream.VelocityX + i);
+		const VectorRegister velocityY = VectorLoad(Stream.VelocityY + i);
+		const VectorRegister velocityZ = VectorLoad(Stream.VelocityZ + i);
+		const VectorRegister gravityZ = VectorLoad(Stream.GravityZ + i);
+		const VectorRegister lifeTime = VectorLoad(Stream.LifeTime + i);
+
+		const VectorRegister newPositionZ = VectorAdd(
+			VectorAdd(positionZ, VectorMultiply(velocityZ, deltaSeconds)),
+			VectorMultiply(gravityZ, halfDeltaSquaredRegister)
+		);
+
+		VectorStore(VectorAdd(positionX, VectorMultiply(velocityX, deltaSeconds)), Stream.PositionX + i);
+		VectorStore(VectorAdd(positionY, VectorMultiply(velocityY, deltaSeconds)), Stream.PositionY + i);
+		VectorStore(newPositionZ, Stream.PositionZ + i);
+		VectorStore(VectorAdd(velocityZ, VectorMultiply(gravityZ, deltaSeconds)), Stream.VelocityZ + i);
+		VectorStore(VectorSubtract(lifeTime, deltaSeconds), Stream.LifeTime + i);
+	}
+
+	// one projectile per register, the same operations as above
+	for (int32 i = vectorNum; i < Stream.Num; i++)
+	{
+		const VectorRegister positionX = VectorLoadFloat1(Stream.PositionX + i);
+		const VectorRegister positionY = VectorLoadFloat1(Stream.PositionY + i);
+		const VectorRegister positionZ = VectorLoadFloat1(Stream.PositionZ + i);
+		const VectorRegister velocityX = VectorLoadFloat1(Stream.VelocityX + i);
+		const VectorRegister velocityY = VectorLoadFloat1(Stream.VelocityY + i);
+		const VectorRegister velocityZ = VectorLoadFloat1(Stream.VelocityZ + i);
+		const VectorRegister gravityZ = VectorLoadFloat1(Stream.GravityZ + i);
+		const VectorRegister lifeTime = VectorLoadFloat1(Stream.LifeTime + i);
+
+		const VectorRegister newPositionZ = VectorAdd(
+			VectorAdd(positionZ, VectorMultiply(velocityZ, deltaSeconds)),
+			VectorMultiply(gravityZ, halfDeltaSquaredRegister)
+		);
+
+		VectorStoreFloat1(VectorAdd(positionX, VectorMultiply(velocityX, deltaSeconds)), Stream.PositionX + i);
+		VectorStoreFloat1(VectorAdd(positionY, VectorMultiply(velocityY, deltaSeconds)), Stream.PositionY + i);
+		VectorStoreFloat1(newPositionZ, Stream.PositionZ + i);
+		VectorStoreFloat1(VectorAdd(velocityZ, VectorMultiply(gravityZ, deltaSeconds)), Stream.VelocityZ + i);
+		VectorStoreFloat1(VectorSubtract(lifeTime, deltaSeconds), Stream.LifeTime + i);
+	}
+}
@@ -0,0 +1,186 @@
+#include "Library/WeaponSpecCache.h"
+#include "Engine/CurveTable.h"
+#include "Engine/DataTable.h"
+
+#include "Actor/TPS_Projectile.h"
+#include "DataAsset/ProjectileParticleDataAsset.h"
+#include "DataAsset/ProjectileSoundDataAsset.h"
+#include "Library/HitResponseTable.h"
+#include "Library/SharedTableCache.h"
+#include "Struct/TableStruct/WeaponTableStruct.h"
+
+namespace WeaponSpecCache
+{
+	/** weapon table, RPM table */
+	typedef TPair<TWeakObjectPtr<const UDataTable>, TWeakObjectPtr<const UCurveTable>> FCachedTableKey;
+
+	static TSharedTableCache<FCachedTableKey, FWeaponSpecTable> CachedTables;
+
+	static void BuildWeaponSpecTable(const UDataTable* WeaponTable, const UCurveTable* RPMTable, FWeaponSpecTable& OutSpecTable)
+	{
+		static const FString contextString(TEXT("Weapon Spec Cache"));
+		static const FWeaponMode defaultWeaponMode;
+
+		OutSpecTable.WeaponNames = WeaponTable->GetRowNames();
+		OutSpecTable.WeaponSpecs.SetNum(OutSpecTable.WeaponNames.Num());
+
+		for (int32 i = 0; i < OutSpecTable.WeaponNames.Num(); i++)
+		{
+			// every spec is built, an unreadable row get the default weapon so the index still match the row name
+			const FWeaponModeCompact* weaponModeRow = WeaponTable->FindRow<FWeaponModeCompact>(OutSpecTable.WeaponNames[i], contextString, true);
+			const FWeaponMode& weaponMode = weaponModeRow ? weaponModeRow->WeaponMode : defaultWeaponMode;
+
+			FWeaponSpecCache::BuildWeaponSpec(weaponMode, OutSpecTable.WeaponSpecs[i]);
+			FWeaponSpecCache::BakeSpinUp(RPMTable, OutSpecTable.WeaponNames[i], OutSpecTable.WeaponSpecs[i]);
+
+			if (weaponMode.Weapon.SocketName.Num() > FWeaponSpec::MaxMuzzleCount)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Weapon %s has %i muzzles, only the first %i are used"),
+					*OutSpecTable.WeaponNames[i].ToString(), weaponMode.Weapon.SocketName.Num(), FWeaponSpec::MaxMuzzleCount);
+			}
+		}
+	}
+
+#if WITH_EDITOR
+	static void MarkStale(const UObject* ChangedTable)
+	{
+		CachedTables.MarkStale([ChangedTable](const FCachedTableKey& TableKey)
+		{
+			return TableKey.Key.Get() == ChangedTable || TableKey.Value.Get() == ChangedTable;
+		});
+	}
+#endif
+}
+
+//===========================================================================
+// public function:
+//===========================================================================
+
+const FWeaponSpecTable* FWeaponSpecCache::GetWeaponSpecs(const UDataTable* WeaponTable, const UCurveTable* RPMTable)
+{
+	using namespace WeaponSpecCache;
+
+	check(IsInGameThread());
+
+	if (WeaponTable == nullptr) return nullptr;
+
+	const FCachedTableKey tableKey(WeaponTable, RPMTable);
+	if (const FWeaponSpecTable* specTable = CachedTables.Find(tableKey)) return specTable;
+
+	bool bIsNewKey;
+	FWeaponSpecTable& specTable = CachedTables.Add(tableKey, bIsNewKey);
+
+#if WITH_EDITOR
+	// the tables can be edited between two play sessions
+	if (bIsNewKey)
+	{
+		const_cast<UDataTable*>(WeaponTable)->OnDataTableChanged().AddStatic(&WeaponSpecCache::MarkStale, (const UObject*)WeaponTable);
+		if (RPMTable) const_cast<UCurveTable*>(RPMTable)->OnCurveTableChanged().AddStatic(&WeaponSpecCache::MarkStale, (const UObject*)RPMTable);
+	}
+#endif
+
+	BuildWeaponSpecTable(WeaponTable, RPMTable, specTable);
+
+	return &specTable;
+}
+
+void FWeaponSpecCache::BuildWeaponSpec(const FWeaponMode& WeaponMode, FWeaponSpec& OutSpec)
+{
+	static const FWeapon defaultWeapon;
+	static const FProjectileData defaultProjectile;
+
+	const FWeapon& weapon = WeaponMode.Weapon;
+	const FProjectile& projectile = WeaponMode.Projectile;
+
+	OutSpec.MuzzleCount = FMath::Min(weapon.SocketName.Num(), FWeaponSpec::MaxMuzzleCount);
+	for (int32 i = 0; i < OutSpec.MuzzleCount; i++)
+	{
+		OutSpec.MuzzleNames[i] = weapon.SocketName[i];
+	}
+
+	const TArray<float>& fireRateAndOther = weapon.FireRateAndOther;
+	// 0 would fire FFireScheduler::MaxRoundsPerFrame round every frame
+	OutSpec.FireRate = (fireRateAndOther.Num() > 0 && fireRateAndOther[0] > KINDA_SMALL_NUMBER) ? fireRateAndOther[0] : defaultWeapon.FireRateAndOther[0];
+	OutSpec.MaxHoldTime = (fireRateAndOther.Num() > 1) ? fireRateAndOther[1] : OutSpec.FireRate;
+	OutSpec.SpinUpTime = (fireRateAndOther.Num() > 5) ? fireRateAndOther[5] : 0.0f;
+	OutSpec.SpinDownTime = (fireRateAndOther.Num() > 6) ? fireRateAndOther[6] : OutSpec.SpinUpTime;
+
+	OutSpec.Trigger = weapon.Trigger;
+	OutSpec.WeaponCost = weapon.WeaponCost;
+	OutSpec.AmmoType = weapon.AmmoType;
+	OutSpec.EnergyType = weapon.EnergyType;
+	OutSpec.EnergyUsePerShot = weapon.EnergyUsePerShot;
+
+	const TArray<float>& speedxGravityxScale = projectile.ProjectileData.SpeedxGravityxScale;
+	FProjectileSpec& projectileSpec = OutSpec.Projectile;
+	projectileSpec.Speed = (speedxGravityxScale.Num() > 0) ? speedxGravityxScale[0] : defaultProjectile.SpeedxGravityxScale[0];
+	projectileSpec.GravityScale = (speedxGravityxScale.Num() > 1) ? speedxGravityxScale[1] : 0.0f;
+	projectileSpec.ParticleScale = (speedxGravityxScale.Num() > 2) ? speedxGravityxScale[2] : 1.0f;
+	projectileSpec.MaxLifeTime = FMath::Max(projectile.ProjectileData.MaxLifeTime, 0.0f);
+	projectileSpec.MaxRange = FMath::Max(projectile.ProjectileData.MaxRange, 0.0f);
+	projectileSpec.bIsHitscan = projectile.ProjectileData.HitscanSpeed > 0.0f && projectileSpec.Speed >= projectile.ProjectileData.HitscanSpeed;
+	projectileSpec.ProjectileClass = projectile.ProjectileClass ? *projectile.ProjectileClass : ATPS_Projectile::StaticClass();
+	projectileSpec.ParticleAsset = projectile.ProjectileParticle;
+	projectileSpec.SoundAsset = projectile.ProjectileSound;
+
+	// usable (silent, no FX) until the asset are streamed in, even if they are already in memory:
+	// the cache is static and not seen by the garbage collector, only a streamable handle keep them alive
+	ClearProjectileAssets(projectileSpec);
+}
+
+void FWeaponSpecCache::ResolveProjectileAssets(FProjectileSpec& OutSpec)
+{
+	check(IsInGameThread());
+
+	OutSpec.ParticleObject = OutSpec.ParticleAsset.Get();
+	OutSpec.SoundObject = OutSpec.SoundAsset.Get();
+	OutSpec.HitResponses = FHitResponseCache::GetHitResponses(OutSpec.ParticleObject, OutSpec.SoundObject);
+
+	const UProjectileSoundDataAsset* soundObject = OutSpec.SoundObject;
+	const TArray<USoundBase*>* hitAndTrailSound = soundObject ? &soundObject->ProjectileSound.HitAndTrailSound : nullptr;
+	OutSpec.MuzzleSound = soundObject ? soundObject->ProjectileSound.MuzzleSound : nullptr;
+	OutSpec.FireLoopSound = soundObject ? soundObject->ProjectileSound.FireLoopSound : nullptr;
+	OutSpec.FireTailSound = (hitAndTrailSound && hitAndTrailSound->Num() > 1) ? (*hitAndTrailSound)[1] : nullptr;
+	OutSpec.MaxMuzzleVoice = soundObject ? FMath::Max(soundObject->ProjectileSound.MaxMuzzleVoice, 1) : 1;
+
+	const UProjectileParticleDataAsset* particleObject = OutSpec.ParticleObject;
+	OutSpec.bHasTrail = particleObject
+		&& particleObject->ProjectileParticle.TrailParticle.Num() > 0
+		&& particleObject->ProjectileParticle.TrailParticle[0] != nullptr;
+
+	OutSpec.bAssetsResolved = true;
+}
+
+void FWeaponSpecCache::ClearProjectileAssets(FProjectileSpec& OutSpec)
+{
+	OutSpec.bAssetsResolved = false;
+	OutSpec.ParticleObject = nullptr;
+	OutSpec.SoundObject = nullptr;
+	OutSpec.MuzzleSound = nullptr;
+	OutSpec.FireLoopSound = nullptr;
+	OutSpec.FireTailSound = nullptr;
+	OutSpec.MaxMuzzleVoice = 1;
+	OutSpec.HitResponses = FHitResponseCache::GetHitResponses(nullptr, nullptr);
+	OutSpec.bHasTrail = false;
+}
+
+bool FWeaponSpecCache::BakeSpinUp(const UCurveTable* RPMTable, const FName RowName, FWeaponSpec& OutSpec)
+{
+	static const FString contextString(TEXT("Weapon Spec Cache"));
+
+	OutSpec.bHasSpinUp = false;
+
+	if (RPMTable == nullptr) return false;
+
+	const FRealCurve* rpmCurve = RPMTable->FindCurve(RowName, contextString, false);
+	if (rpmCurve == nullptr) return false;
+
+	for (int32 i = 0; i < FWeaponSpec::SpinSampleCount; i++)
+	{
+		OutSpec.SpinRoundsPerSecond[i] = rpmCurve->Eval((float)i / (FWeaponSpec::SpinSampleCount - 1));
+	}
+
+	OutSpec.bHasSpinUp = true;
+
+	return true;
+}
@@ -0,0 +1,87 @@
+#include "Engine/DataTable.h"
+#include "Misc/AutomationTest.h"
+
+#include "Component/AimingComponent.h"
+#include "Library/AimingProfileCache.h"
+#include "Tests/TPSTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAimingProfileBenchmark, "TPS_study.Benchmark.AimingProfile",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FAimingProfileBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 shooterCount = 500;
+
+	UDataTable* weaponTable = FTPSTestWorld::MakeWeaponTable({ FTPSTestWorld::MakeWeaponMode(ETriggerMechanism::PressTrigger, 0.1f, 0.1f, 8000.0f, 1.0f) });
+
+	FTPSTestWorld testWorld;
+	TArray<ATPShooterCharacter*> shooters;
+	TArray<double> spawnTimes;
+
+	// spawn include the BeginPlay of every component, the aiming one read its table there
+	for (int32 i = 0; i < shooterCount; i++)
+	{
+		const double startTime = FPlatformTime::Seconds();
+		ATPShooterCharacter* shooter = testWorld.SpawnShooter(weaponTable, FVector((i % 25) * 200.0f, (i / 25) * 200.0f, 0.0f));
+		spawnTimes.Add(FPlatformTime::Seconds() - startTime);
+
+		if (!TestNotNull(TEXT("shooter"), shooter)) return false;
+		shooters.Add(shooter);
+	}
+
+	// the table the component actually use (protected default)
+	const UDataTable* aimingTable = nullptr;
+	if (const UObjectProperty* aimingTableProperty = FindField<UObjectProperty>(UAimingComponent::StaticClass(), TEXT("AimingTable")))
+	{
+		aimingTable = Cast<UDataTable>(aimingTableProperty->GetObjectPropertyValue_InContainer(shooters[0]->GetAiming()));
+	}
+	if (!TestNotNull(TEXT("aiming table"), aimingTable)) return false;
+
+	const FAimingProfileTable* aimingProfiles = FAimingProfileCache::GetAimingProfiles(aimingTable);
+	if (!TestNotNull(TEXT("aiming profiles"), aimingProfiles)) return false;
+
+	// before: every character FindRow each row into its own TArray<FAimingStat>
+	TArray<TArray<FAimingStat>> copiedAimStats;
+	copiedAimStats.SetNum(shooterCount);
+
+	const TArray<FName> rowNames = aimingTable->GetRowNames();
+	const double copyStartTime = FPlatformTime::Seconds();
+
+	for (TArray<FAimingStat>& aimStats : copiedAimStats)
+	{
+		for (const FName rowName : rowNames)
+		{
+			if (const FAimingStatCompact* aimingRow = aimingTable->FindRow<FAimingStatCompact>(rowName, TEXT("AimingProfileBenchmark")))
+			{
+				aimStats.Add(aimingRow->AimStat);
+			}
+		}
+	}
+
+	const double copyTime = (FPlatformTime::Seconds() - copyStartTime) / shooterCount;
+
+	// per character: the default stat it always had, plus the rows (before) or a pointer to the shared table (after)
+	const SIZE_T beforeBytes = sizeof(FAimingStat) + sizeof(TArray<FAimingStat>) + copiedAimStats[0].GetAllocatedSize();
+	const SIZE_T afterBytes = sizeof(FAimingStat) + sizeof(const FAimingProfileTable*);
+	const SIZE_T sharedBytes = sizeof(FAimingProfileTable) + aimingProfiles->AimStats.GetAllocatedSize() + aimingProfiles->AimingNames.GetAllocatedSize();
+
+	TestEqual(TEXT("shared table has every row"), aimingProfiles->Num(), rowNames.Num());
+
+	const double firstSpawnTime = spawnTimes[0];
+	spawnTimes.RemoveAt(0);
+	const double spawnTime = FTPSTestWorld::GetMedian(spawnTimes);
+
+	// timing depends on the machine and the build, reported only
+	AddInfo(FString::Printf(TEXT("%i aiming row, %i character"), rowNames.Num(), shooterCount));
+	AddInfo(FString::Printf(TEXT("aiming memory per character: before %u byte, after %u byte, shared table %u byte once"), (uint32)beforeBytes, (uint32)afterBytes, (uint32)sharedBytes));
+	AddInfo(FString::Printf(TEXT("aiming memory for %i character: before %.1f KB, after %.1f KB"), shooterCount,
+		beforeBytes * shooterCount / 1024.0, (afterBytes * shooterCount + sharedBytes) / 1024.0));
+	AddInfo(FString::Printf(TEXT("spawn with BeginPlay: first %.3f ms (build the shared table unless already cached), median of the rest %.3f ms"), firstSpawnTime * 1000.0, spawnTime * 1000.0));
+	AddInfo(FString::Printf(TEXT("row copy the old BeginPlay did: %.2f us per character"), copyTime * 1.e6));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,123 @@
+#include "Misc/AutomationTest.h"
+
+#include "Component/AimingComponent.h"
+#include "Tests/TPSTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AimingTickBenchmark
+{
+	static int32 CountTickingComponents(const TArray<UAimingComponent*>& AimingComponents)
+	{
+		int32 tickingCount = 0;
+		for (const UAimingComponent* aimingComponent : AimingComponents)
+		{
+			if (aimingComponent->IsComponentTickEnabled()) tickingCount++;
+		}
+		return tickingCount;
+	}
+
+	/** tick until no aiming component tick anymore (MaxFrameCount at most), the number ticking each frame go in OutTickingCounts */
+	static void TickUntilIdle(FTPSTestWorld& TestWorld, const TArray<UAimingComponent*>& AimingComponents, const int32 MaxFrameCount, TArray<int32>& OutTickingCounts)
+	{
+		for (int32 frame = 0; frame < MaxFrameCount; frame++)
+		{
+			const int32 tickingCount = CountTickingComponents(AimingComponents);
+			OutTickingCounts.Add(tickingCount);
+
+			if (tickingCount == 0) return;
+
+			TestWorld.Tick(1.0f / 60.0f);
+		}
+	}
+
+	static FString DescribeTickingCounts(const TArray<int32>& TickingCounts)
+	{
+		int32 maxCount = 0;
+		int32 totalCount = 0;
+		for (const int32 tickingCount : TickingCounts)
+		{
+			maxCount = FMath::Max(maxCount, tickingCount);
+			totalCount += tickingCount;
+		}
+
+		return FString::Printf(TEXT("%i frame, at most %i ticking, %.1f per frame on average, %i component tick in total"),
+			TickingCounts.Num(), maxCount, totalCount / (float)FMath::Max(TickingCounts.Num(), 1), totalCount);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAimingTickBenchmark, "TPS_study.Benchmark.AimingTick",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FAimingTickBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace AimingTickBenchmark;
+
+	// 200 character, a quarter of them start aiming, then half of those stop
+	const int32 shooterCount = 200;
+	const int32 aimingCount = 50;
+	const int32 stopAimingCount = 25;
+	const int32 idleFrameCount = 60;
+
+	// a transition take TotalAimingTime (0.8 second), 10 second is far past it
+	const int32 maxTransitionFrameCount = 600;
+
+	UDataTable* weaponTable = FTPSTestWorld::MakeWeaponTable({ FTPSTestWorld::MakeWeaponMode(ETriggerMechanism::PressTrigger, 0.1f, 0.1f, 8000.0f, 1.0f) });
+
+	FTPSTestWorld testWorld;
+	TArray<UAimingComponent*> aimingComponents;
+
+	for (int32 i = 0; i < shooterCount; i++)
+	{
+		ATPShooterCharacter* shooter = testWorld.SpawnShooter(weaponTable, FVector((i % 20) * 200.0f, (i / 20) * 200.0f, 0.0f), false);
+		if (!TestNotNull(TEXT("shooter"), shooter)) return false;
+
+		aimingComponents.Add(shooter->GetAiming());
+	}
+
+	// nobody aim, nobody tick
+	TArray<int32> idleTickingCounts;
+	for (int32 frame = 0; frame < idleFrameCount; frame++)
+	{
+		idleTickingCounts.Add(CountTickingComponents(aimingComponents));
+		testWorld.Tick(1.0f / 60.0f);
+	}
+
+	for (int32 i = 0; i < aimingCount; i++)
+	{
+		aimingComponents[i]->AimingPress();
+	}
+
+	TArray<int32> aimTickingCounts;
+	TickUntilIdle(testWorld, aimingComponents, maxTransitionFrameCount, aimTickingCounts);
+
+	for (int32 i = 0; i < stopAimingCount; i++)
+	{
+		aimingComponents[i]->AimingRelease();
+	}
+
+	TArray<int32> releaseTickingCounts;
+	TickUntilIdle(testWorld, aimingComponents, maxTransitionFrameCount, releaseTickingCounts);
+
+	TestEqual(TEXT("aiming component ticking while idle"), FMath::Max(idleTickingCounts), 0);
+	TestEqual(TEXT("aiming component ticking during the aim transition"), aimTickingCounts[0], aimingCount);
+	TestEqual(TEXT("aiming component ticking once the aim transition is over"), aimTickingCounts.Last(), 0);
+	TestEqual(TEXT("aiming component ticking during the stop transition"), releaseTickingCounts[0], stopAimingCount);
+	TestEqual(TEXT("aiming component ticking once the stop transition is over"), releaseTickingCounts.Last(), 0);
+
+	int32 stillAimingCount = 0;
+	for (const UAimingComponent* aimingComponent : aimingComponents)
+	{
+		if (aimingComponent->GetIsAiming()) stillAimingCount++;
+	}
+	TestEqual(TEXT("character still aiming"), stillAimingCount, aimingCount - stopAimingCount);
+
+	AddInfo(FString::Printf(TEXT("%i character, idle: %s"), shooterCount, *DescribeTickingCounts(idleTickingCounts)));
+	AddInfo(FString::Printf(TEXT("%i start aiming: %s"), aimingCount, *DescribeTickingCounts(aimTickingCounts)));
+	AddInfo(FString::Printf(TEXT("%i stop aiming: %s"), stopAimingCount, *DescribeTickingCounts(releaseTickingCounts)));
+	AddInfo(TEXT("in game, stat TPS show the same count per frame as Aiming Tick"));
+
+	return true;
+}
+
+#endif
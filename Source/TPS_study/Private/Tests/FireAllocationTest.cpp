@@ -0,0 +1,116 @@
+#include "HAL/MemoryBase.h"
+#include "Misc/AutomationTest.h"
+
+#include "Actor/TPS_ProjectileSimulation.h"
+#include "Library/TPSFunctionLibrary.h"
+#include "Tests/TPSTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FireAllocationTest
+{
+	/** forward everything to the real allocator, count the game thread allocation while bIsCounting */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		FMalloc* InnerMalloc = nullptr;
+		bool bIsCounting = false;
+		int32 AllocationCount = 0;
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->Malloc(Size, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override
+		{
+			// a grow or a shrink touch the heap too
+			if (Size > 0) CountAllocation();
+			return InnerMalloc->Realloc(Original, Size, Alignment);
+		}
+
+		virtual void Free(void* Original) override { InnerMalloc->Free(Original); }
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return InnerMalloc->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return InnerMalloc->GetAllocationSize(Original, SizeOut); }
+		virtual void SetupTLSCachesOnCurrentThread() override { InnerMalloc->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool IsInternallyThreadSafe() const override { return InnerMalloc->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return InnerMalloc->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("TPS counting malloc"); }
+
+	private:
+		void CountAllocation()
+		{
+			// other thread (audio, render, task graph) keep allocating, only the fire path is measured
+			if (bIsCounting && IsInGameThread()) AllocationCount++;
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFireAllocationTest, "TPS_study.Weapon.FireAllocation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFireAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace FireAllocationTest;
+
+	const int32 warmUpShotCount = 200;
+	const int32 shotCount = 10000;
+
+	// one frame per shot, a little longer than the fire rate so every press fire
+	const float fireRate = 0.05f;
+	const float frameTime = 0.06f;
+
+	FTPSTestWorld testWorld;
+
+	UDataTable* weaponTable = FTPSTestWorld::MakeWeaponTable({ FTPSTestWorld::MakeWeaponMode(ETriggerMechanism::PressTrigger, fireRate, fireRate, 8000.0f, 0.5f) });
+	ATPShooterCharacter* shooter = testWorld.SpawnShooter(weaponTable, FVector::ZeroVector);
+	if (!TestNotNull(TEXT("shooter"), shooter)) return false;
+
+	URangedWeaponComponent* rangedWeapon = shooter->GetRangedWeapon();
+	ATPS_ProjectileSimulation* projectileSimulation = UTPSFunctionLibrary::GetWorldManager<ATPS_ProjectileSimulation>(testWorld.World);
+	if (!TestNotNull(TEXT("projectile simulation"), projectileSimulation)) return false;
+
+	// the pre-warm, the projectile arrays and the aim query reach their steady size here
+	for (int32 i = 0; i < warmUpShotCount; i++)
+	{
+		rangedWeapon->FirePress();
+		rangedWeapon->FireRelease();
+		testWorld.Tick(frameTime);
+	}
+
+	const int32 firedBefore = projectileSimulation->GetProjectileCount() + projectileSimulation->GetExpiredCount();
+
+	// never deleted, another thread may still be inside it after GMalloc is restored
+	static FCountingMalloc* countingMalloc = new FCountingMalloc();
+	countingMalloc->InnerMalloc = GMalloc;
+	countingMalloc->AllocationCount = 0;
+	GMalloc = countingMalloc;
+
+	// only the fire call are counted, the world tick in between (physics, timer, GC bookkeeping) is not the fire path
+	for (int32 i = 0; i < shotCount; i++)
+	{
+		countingMalloc->bIsCounting = true;
+		rangedWeapon->FirePress();
+		rangedWeapon->FireRelease();
+		countingMalloc->bIsCounting = false;
+
+		testWorld.Tick(frameTime);
+	}
+
+	GMalloc = countingMalloc->InnerMalloc;
+
+	const int32 firedCount = projectileSimulation->GetProjectileCount() + projectileSimulation->GetExpiredCount() - firedBefore;
+
+	TestEqual(TEXT("every press fired"), firedCount, shotCount);
+	TestEqual(TEXT("heap allocation in the fire path"), countingMalloc->AllocationCount, 0);
+
+	AddInfo(FString::Printf(TEXT("%i shot, %i heap allocation (%.3f per shot)"),
+		firedCount, countingMalloc->AllocationCount, countingMalloc->AllocationCount / (float)FMath::Max(firedCount, 1)));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,62 @@
+#include "Library/FireScheduler.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFireSchedulerTest, "TPS_study.Weapon.FireScheduler",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFireSchedulerTest::RunTest(const FString& Parameters)
+{
+	// round k is due at k * fireInterval, a hold fire round 0 to holdTime / fireInterval whatever the frame rate
+	// (142.86 here, far from an integer so the float rounding of the due time cannot add or drop the last round)
+	const float fireInterval = 0.07f;
+	const float holdTime = 10.0f;
+	const int32 expectedRoundCount = FMath::FloorToInt(holdTime / fireInterval) + 1;
+
+	// the due time is accumulated in float, 10 second of it drift a little more than a 1 second hold
+	const float offsetTolerance = 1.e-3f;
+
+	float timeOffsets[FFireScheduler::MaxRoundsPerFrame];
+
+	for (const int32 frameRate : { 20, 30, 60, 144 })
+	{
+		FFireScheduler fireScheduler;
+		fireScheduler.FireNow(0.0f, fireInterval);
+
+		int32 roundCount = 1;
+		const int32 frameCount = FMath::RoundToInt(holdTime * frameRate);
+
+		for (int32 frame = 1; frame <= frameCount; frame++)
+		{
+			// synthetic timestamp, not accumulated, so the test does not drift on its own
+			const float now = (float)((double)frame / frameRate);
+			const int32 dueRounds = fireScheduler.ConsumeDueRounds(now, fireInterval, timeOffsets);
+
+			for (int32 i = 0; i < dueRounds; i++)
+			{
+				const float expectedOffset = now - (roundCount + i) * fireInterval;
+				TestTrue(FString::Printf(TEXT("%i fps, round %i offset %f is %f"), frameRate, roundCount + i, timeOffsets[i], expectedOffset),
+					FMath::IsNearlyEqual(timeOffsets[i], expectedOffset, offsetTolerance));
+				TestTrue(FString::Printf(TEXT("%i fps, round %i is late by less than a frame"), frameRate, roundCount + i),
+					timeOffsets[i] >= 0.0f && timeOffsets[i] < 1.0f / frameRate + offsetTolerance);
+			}
+
+			roundCount += dueRounds;
+		}
+
+		TestEqual(FString::Printf(TEXT("%i fps round count"), frameRate), roundCount, expectedRoundCount);
+	}
+
+	// a hitch fire at most MaxRoundsPerFrame round and drop the rest
+	FFireScheduler fireScheduler;
+	fireScheduler.FireNow(0.0f, fireInterval);
+
+	TestEqual(TEXT("hitch round count"), fireScheduler.ConsumeDueRounds(2.0f, fireInterval, timeOffsets), FFireScheduler::MaxRoundsPerFrame);
+	TestEqual(TEXT("round after the hitch"), fireScheduler.ConsumeDueRounds(2.0f + fireInterval * 0.5f, fireInterval, timeOffsets), 0);
+	TestEqual(TEXT("round one interval after the hitch"), fireScheduler.ConsumeDueRounds(2.0f + fireInterval, fireInterval, timeOffsets), 1);
+
+	return true;
+}
+
+#endif
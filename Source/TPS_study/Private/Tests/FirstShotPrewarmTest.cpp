@@ -0,0 +1,112 @@
+#include "Misc/AutomationTest.h"
+#include "Particles/ParticleSystem.h"
+
+#include "Actor/TPS_FXManager.h"
+#include "Actor/TPS_ProjectilePool.h"
+#include "Actor/TPS_ProjectileSimulation.h"
+#include "DataAsset/ProjectileParticleDataAsset.h"
+#include "Library/TPSFunctionLibrary.h"
+#include "Tests/TPSTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FirstShotPrewarmTest
+{
+	struct FShotFrameTimes
+	{
+		double FirstShot;
+
+		/** median of the shots after the first */
+		double SteadyState;
+
+		/** projectile spawned by the first shot because the pool of its class was empty */
+		int32 FirstShotPoolMiss;
+
+		/** muzzle and trail component created by the first shot because their FX pool was empty */
+		int32 FirstShotFXPoolMiss;
+	};
+
+	/** one shot per 60 fps frame after a weapon switch, with or without the pre-warm */
+	static FShotFrameTimes MeasureShotFrames(const bool bPrewarm)
+	{
+		const int32 steadyShotCount = 60;
+		const float frameTime = 1.0f / 60.0f;
+
+		FTPSTestWorld testWorld;
+
+		ATPS_ProjectileSimulation* projectileSimulation = UTPSFunctionLibrary::GetWorldManager<ATPS_ProjectileSimulation>(testWorld.World);
+		ATPS_ProjectilePool* projectilePool = UTPSFunctionLibrary::GetWorldManager<ATPS_ProjectilePool>(testWorld.World);
+		ATPS_FXManager* fxManager = UTPSFunctionLibrary::GetWorldManager<ATPS_FXManager>(testWorld.World);
+
+		// a muzzle and a trail (empty template), so every shot take a projectile and two FX component from the pools
+		UProjectileParticleDataAsset* particleObject = NewObject<UProjectileParticleDataAsset>();
+		particleObject->ProjectileParticle.MuzzleParticle = { NewObject<UParticleSystem>(particleObject) };
+		particleObject->ProjectileParticle.TrailParticle = { NewObject<UParticleSystem>(particleObject) };
+
+		FProjectileSpec projectileSpec = FTPSTestWorld::MakeProjectileSpec(5000.0f, 1.0f, 0.0f);
+		projectileSpec.ParticleAsset = particleObject;
+		FWeaponSpecCache::ResolveProjectileAssets(projectileSpec);
+
+		// the switch frame, then what URangedWeaponComponent::PrewarmNeighbourWeapons do after PrewarmDelay
+		testWorld.Tick(frameTime);
+		if (bPrewarm) projectileSimulation->PrewarmProjectile(projectileSpec);
+		testWorld.Tick(frameTime);
+
+		FShotFrameTimes frameTimes;
+		TArray<double> steadyFrameTimes;
+
+		for (int32 shot = 0; shot <= steadyShotCount; shot++)
+		{
+			const int32 poolMissCount = projectilePool->GetMissCount();
+			const int32 fxPoolMissCount = fxManager->GetPoolMissCount();
+			const double startTime = FPlatformTime::Seconds();
+
+			projectileSimulation->AddProjectile(projectileSpec, nullptr, FTransform(FRotator(0.0f, shot * 5.0f, 0.0f), FVector::ZeroVector));
+			testWorld.Tick(frameTime);
+
+			const double shotFrameTime = FPlatformTime::Seconds() - startTime;
+
+			if (shot == 0)
+			{
+				frameTimes.FirstShot = shotFrameTime;
+				frameTimes.FirstShotPoolMiss = projectilePool->GetMissCount() - poolMissCount;
+				frameTimes.FirstShotFXPoolMiss = fxManager->GetPoolMissCount() - fxPoolMissCount;
+			}
+			else
+			{
+				steadyFrameTimes.Add(shotFrameTime);
+			}
+		}
+
+		frameTimes.SteadyState = FTPSTestWorld::GetMedian(steadyFrameTimes);
+
+		return frameTimes;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFirstShotPrewarmTest, "TPS_study.Weapon.FirstShotPrewarm",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFirstShotPrewarmTest::RunTest(const FString& Parameters)
+{
+	using namespace FirstShotPrewarmTest;
+
+	const FShotFrameTimes coldFrameTimes = MeasureShotFrames(false);
+	const FShotFrameTimes warmFrameTimes = MeasureShotFrames(true);
+
+	AddInfo(FString::Printf(TEXT("without pre-warm: first shot %.3f ms, steady state %.3f ms"), coldFrameTimes.FirstShot * 1000.0, coldFrameTimes.SteadyState * 1000.0));
+	AddInfo(FString::Printf(TEXT("with pre-warm: first shot %.3f ms, steady state %.3f ms"), warmFrameTimes.FirstShot * 1000.0, warmFrameTimes.SteadyState * 1000.0));
+
+	// the pool of a class is created (PrewarmCount actor spawned) by its first use, at the switch with the pre-warm
+	TestEqual(TEXT("pool miss on the first shot after a pre-warmed switch"), warmFrameTimes.FirstShotPoolMiss, 0);
+
+	// a FX pool is only filled by a pre-warm, otherwise the first shot create its muzzle and trail component
+	TestTrue(TEXT("FX pool miss on the first shot of a cold switch"), coldFrameTimes.FirstShotFXPoolMiss > 0);
+	TestEqual(TEXT("FX pool miss on the first shot after a pre-warmed switch"), warmFrameTimes.FirstShotFXPoolMiss, 0);
+
+	// the frame time depend on the machine and what else run on it, so it is reported above and not asserted
+
+	return true;
+}
+
+#endif
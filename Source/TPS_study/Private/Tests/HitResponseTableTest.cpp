@@ -0,0 +1,72 @@
+#include "Library/HitResponseTable.h"
+#include "Misc/AutomationTest.h"
+#include "Particles/ParticleSystem.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Sound/SoundCue.h"
+
+#include "Custom/CustomPhysicalSurface.h"
+#include "DataAsset/ProjectileParticleDataAsset.h"
+#include "DataAsset/ProjectileSoundDataAsset.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHitResponseTableTest, "TPS_study.Projectile.HitResponseTable",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FHitResponseTableTest::RunTest(const FString& Parameters)
+{
+	// transient asset, the table is built directly so the shared cache is not touched
+	UParticleSystem* hitWorld = NewObject<UParticleSystem>();
+	UParticleSystem* hitCharacter = NewObject<UParticleSystem>();
+	UParticleSystem* hitWater = NewObject<UParticleSystem>();
+	UParticleSystem* noHit = NewObject<UParticleSystem>();
+	USoundCue* hitSound = NewObject<USoundCue>();
+
+	UProjectileParticleDataAsset* particleObject = NewObject<UProjectileParticleDataAsset>();
+	particleObject->ProjectileParticle.HitParticle = { hitWorld, hitCharacter, hitWater, noHit };
+
+	UProjectileSoundDataAsset* soundObject = NewObject<UProjectileSoundDataAsset>();
+	soundObject->ProjectileSound.HitAndTrailSound = { hitSound };
+
+	FHitResponseTable hitResponses;
+	FHitResponseCache::BuildHitResponseTable(particleObject, soundObject, hitResponses);
+
+	const int32 world = (int32)EHitChannel::World;
+	const int32 player = (int32)EHitChannel::Player;
+	const int32 enemy = (int32)EHitChannel::Enemy;
+
+	TestTrue(TEXT("world x water"), hitResponses.Responses[world][SurfaceType_Water].Particle == hitWater);
+	TestTrue(TEXT("world x default"), hitResponses.Responses[world][SurfaceType_Default].Particle == hitWorld);
+	TestTrue(TEXT("player x water"), hitResponses.Responses[player][SurfaceType_Water].Particle == hitCharacter);
+	TestTrue(TEXT("enemy x default"), hitResponses.Responses[enemy][SurfaceType_Default].Particle == hitCharacter);
+	TestTrue(TEXT("hit sound"), hitResponses.Responses[world][SurfaceType_Water].Sound == hitSound);
+	TestTrue(TEXT("no hit particle"), hitResponses.NoHitResponse.Particle == noHit);
+	TestTrue(TEXT("no hit has no hit sound"), hitResponses.NoHitResponse.Sound == nullptr);
+
+	// a hit without component is on the world channel, without physical material on the default surface
+	FHitResult hit;
+	TestTrue(TEXT("resolve default surface"), hitResponses.Resolve(hit).Particle == hitWorld);
+
+	UPhysicalMaterial* waterMaterial = NewObject<UPhysicalMaterial>();
+	waterMaterial->SurfaceType = SurfaceType_Water;
+	hit.PhysMaterial = waterMaterial;
+	TestTrue(TEXT("resolve water surface"), hitResponses.Resolve(hit).Particle == hitWater);
+
+	// an asset with only HitWorld play it on character and water too
+	particleObject->ProjectileParticle.HitParticle = { hitWorld };
+	FHitResponseCache::BuildHitResponseTable(particleObject, soundObject, hitResponses);
+
+	TestTrue(TEXT("only HitWorld, world x water"), hitResponses.Responses[world][SurfaceType_Water].Particle == hitWorld);
+	TestTrue(TEXT("only HitWorld, player x default"), hitResponses.Responses[player][SurfaceType_Default].Particle == hitWorld);
+	TestTrue(TEXT("only HitWorld, no hit"), hitResponses.NoHitResponse.Particle == nullptr);
+
+	// no asset at all, every response is empty
+	FHitResponseCache::BuildHitResponseTable(nullptr, nullptr, hitResponses);
+
+	TestTrue(TEXT("no asset, world x water"), hitResponses.Responses[world][SurfaceType_Water].Particle == nullptr);
+	TestTrue(TEXT("no asset, no hit"), hitResponses.NoHitResponse.Particle == nullptr && hitResponses.NoHitResponse.Sound == nullptr);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,103 @@
+#include "Components/BoxComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+#include "Actor/TPS_ProjectileSimulation.h"
+#include "Custom/CustomCollisionChannel.h"
+#include "Library/TPSFunctionLibrary.h"
+#include "Tests/TPSTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHitscanBenchmark, "TPS_study.Benchmark.Hitscan",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FHitscanBenchmark::RunTest(const FString& Parameters)
+{
+	// fast falling round at a row of target with gap between them, some are hit and some miss
+	const float speed = 20000.0f;
+	const float maxLifeTime = 1.5f;
+	const int32 roundsPerFrame = 100;
+	const int32 firingFrameCount = 20;
+	const int32 shotCount = roundsPerFrame * firingFrameCount;
+	const float frameTime = 1.0f / 60.0f;
+
+	IConsoleVariable* hitscan = IConsoleManager::Get().FindConsoleVariable(TEXT("TPS.Projectile.Hitscan"));
+	if (!TestNotNull(TEXT("TPS.Projectile.Hitscan"), hitscan)) return false;
+
+	FProjectileSpec projectileSpec = FTPSTestWorld::MakeProjectileSpec(speed, maxLifeTime, 0.0f);
+	projectileSpec.GravityScale = 1.0f;
+
+	int32 hitCounts[2];
+	double roundTimes[2];
+
+	// simulated, then hitscan
+	for (const int32 forcedHitscan : { 0, 1 })
+	{
+		hitscan->Set(forcedHitscan, ECVF_SetByCode);
+
+		FTPSTestWorld testWorld;
+
+		ATPS_ProjectileSimulation* projectileSimulation = UTPSFunctionLibrary::GetWorldManager<ATPS_ProjectileSimulation>(testWorld.World);
+		if (!TestNotNull(TEXT("projectile simulation"), projectileSimulation)) break;
+
+		for (int32 i = 0; i < 16; i++)
+		{
+			AActor* target = testWorld.World->SpawnActor<AActor>();
+			UBoxComponent* targetBox = NewObject<UBoxComponent>(target);
+			targetBox->SetBoxExtent(FVector(50.0f, 100.0f, 100.0f));
+			targetBox->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+			targetBox->SetCollisionObjectType(ECC_Enemy);
+			targetBox->SetCollisionResponseToAllChannels(ECR_Block);
+			target->SetRootComponent(targetBox);
+			targetBox->RegisterComponent();
+
+			// 300 unit apart, 200 wide: a third of the fan go between two target
+			targetBox->SetWorldLocation(FVector(3000.0f + (i % 4) * 1500.0f, (i - 7.5f) * 300.0f, -100.0f));
+		}
+
+		FRandomStream randomStream(7);
+		double totalTime = 0.0;
+
+		// fire, then tick until every round is resolved (the last one retired or its impact played), the whole cost of a round on the game thread
+		const int32 frameCount = firingFrameCount + FMath::CeilToInt(maxLifeTime / frameTime) + 2;
+
+		for (int32 frame = 0; frame < frameCount; frame++)
+		{
+			const double startTime = FPlatformTime::Seconds();
+
+			if (frame < firingFrameCount)
+			{
+				for (int32 i = 0; i < roundsPerFrame; i++)
+				{
+					const FRotator direction(randomStream.FRandRange(-2.0f, 2.0f), randomStream.FRandRange(-30.0f, 30.0f), 0.0f);
+					projectileSimulation->AddProjectile(projectileSpec, nullptr, FTransform(direction, FVector::ZeroVector), randomStream.FRandRange(0.0f, frameTime));
+				}
+			}
+
+			testWorld.Tick(frameTime);
+			totalTime += FPlatformTime::Seconds() - startTime;
+		}
+
+		TestEqual(FString::Printf(TEXT("%s, every round resolved"), forcedHitscan == 1 ? TEXT("hitscan") : TEXT("simulated")), projectileSimulation->GetProjectileCount(), 0);
+
+		hitCounts[forcedHitscan] = (forcedHitscan == 1) ? projectileSimulation->GetHitscanHitCount() : projectileSimulation->GetHitCount();
+		roundTimes[forcedHitscan] = totalTime / shotCount;
+	}
+
+	hitscan->Set(-1, ECVF_SetByCode);
+
+	// the same random fan both time, the hitscan chords follow the arc so only a grazing round can differ
+	TestTrue(TEXT("some round hit"), hitCounts[0] > 0);
+	TestTrue(TEXT("some round miss"), hitCounts[0] < shotCount);
+	TestTrue(FString::Printf(TEXT("hit parity, simulated %i, hitscan %i"), hitCounts[0], hitCounts[1]),
+		FMath::Abs(hitCounts[0] - hitCounts[1]) <= FMath::Max(shotCount / 100, 1));
+
+	// timing depends on the machine and the build, reported only
+	AddInfo(FString::Printf(TEXT("simulated: %i hit of %i, %.2f us per round (add and every frame until resolved)"), hitCounts[0], shotCount, roundTimes[0] * 1.e6));
+	AddInfo(FString::Printf(TEXT("hitscan: %i hit of %i, %.2f us per round, %.2fx the simulated cost"), hitCounts[1], shotCount, roundTimes[1] * 1.e6, roundTimes[1] / FMath::Max(roundTimes[0], 1.e-12)));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,97 @@
+#include "Library/HoldTrigger.h"
+#include "Misc/AutomationTest.h"
+
+#include "Actor/TPS_ProjectileSimulation.h"
+#include "Library/TPSFunctionLibrary.h"
+#include "Tests/HoldTriggerTestListener.h"
+#include "Tests/TPSTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHoldTriggerTest, "TPS_study.Weapon.HoldTrigger",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FHoldTriggerTest::RunTest(const FString& Parameters)
+{
+	const float maxHoldTime = 0.75f;
+	const float holdDuration = 1.1f;
+
+	// a frame or two before the press, so the press does not land on world time 0
+	const int32 framesBeforePress = 2;
+
+	UDataTable* weaponTable = FTPSTestWorld::MakeWeaponTable({ FTPSTestWorld::MakeWeaponMode(ETriggerMechanism::ReleaseTrigger, 0.2f, maxHoldTime, 8000.0f, 5.0f) });
+
+	for (const int32 frameRate : { 30, 60, 144 })
+	{
+		const float frameTime = 1.0f / frameRate;
+
+		FTPSTestWorld testWorld;
+
+		ATPShooterCharacter* shooter = testWorld.SpawnShooter(weaponTable, FVector::ZeroVector);
+		if (!TestNotNull(TEXT("shooter"), shooter)) return false;
+
+		URangedWeaponComponent* rangedWeapon = shooter->GetRangedWeapon();
+		ATPS_ProjectileSimulation* projectileSimulation = UTPSFunctionLibrary::GetWorldManager<ATPS_ProjectileSimulation>(testWorld.World);
+
+		UHoldTriggerTestListener* listener = NewObject<UHoldTriggerTestListener>();
+		rangedWeapon->OnJustReachMaxHoldTrigger.AddDynamic(listener, &UHoldTriggerTestListener::OnJustReachMaxHold);
+		rangedWeapon->OnMaxFireHoldRelease.AddDynamic(listener, &UHoldTriggerTestListener::OnMaxHoldRelease);
+
+		for (int32 frame = 0; frame < framesBeforePress; frame++)
+		{
+			testWorld.Tick(frameTime);
+		}
+
+		const float pressTime = testWorld.World->GetTimeSeconds();
+		rangedWeapon->FirePress();
+
+		TestEqual(FString::Printf(TEXT("%i fps charge at the press"), frameRate), rangedWeapon->GetChargeFraction(), 0.0f);
+
+		float previousFraction = 0.0f;
+
+		while (testWorld.World->GetTimeSeconds() - pressTime + frameTime <= holdDuration)
+		{
+			// the one shot timer of the max hold run in the world tick
+			testWorld.Tick(frameTime);
+
+			const float now = testWorld.World->GetTimeSeconds();
+			const float chargeFraction = rangedWeapon->GetChargeFraction();
+
+			TestTrue(FString::Printf(TEXT("%i fps charge fraction is continuous"), frameRate), chargeFraction >= previousFraction && chargeFraction <= 1.0f);
+			TestEqual(FString::Printf(TEXT("%i fps charge fraction at %f"), frameRate, now), chargeFraction, FMath::Min((now - pressTime) / maxHoldTime, 1.0f), 1.e-4f);
+			TestEqual(FString::Printf(TEXT("%i fps hold time at %f"), frameRate, now), rangedWeapon->GetHoldTime(), now - pressTime, 1.e-4f);
+			previousFraction = chargeFraction;
+		}
+
+		// the max hold event is broadcast once, on the first frame at or past the threshold, not on a 200 ms step
+		TestEqual(FString::Printf(TEXT("%i fps max hold broadcast"), frameRate), listener->ReachCount, 1);
+		TestTrue(FString::Printf(TEXT("%i fps max hold broadcast at hold time %f, within one frame of %f"), frameRate, listener->ReachHoldTime, maxHoldTime),
+			listener->ReachHoldTime >= maxHoldTime - 1.e-4f && listener->ReachHoldTime < maxHoldTime + frameTime + 1.e-4f);
+		TestEqual(FString::Printf(TEXT("%i fps max hold broadcast at world time"), frameRate), listener->ReachWorldTime - pressTime, listener->ReachHoldTime, 1.e-4f);
+
+		const float releaseTime = testWorld.World->GetTimeSeconds();
+		rangedWeapon->FireRelease();
+
+		TestEqual(FString::Printf(TEXT("%i fps max hold release broadcast"), frameRate), listener->ReleaseCount, 1);
+		TestEqual(FString::Printf(TEXT("%i fps hold time at release"), frameRate), listener->ReleaseHoldTime, releaseTime - pressTime, 1.e-4f);
+		TestEqual(FString::Printf(TEXT("%i fps charge after release"), frameRate), rangedWeapon->GetChargeFraction(), 0.0f);
+
+		if (projectileSimulation)
+		{
+			TestEqual(FString::Printf(TEXT("%i fps one round fired at release"), frameRate), projectileSimulation->GetProjectileCount(), 1);
+		}
+	}
+
+	FHoldTrigger holdTrigger;
+	TestEqual(TEXT("release without press"), holdTrigger.Release(1.0f), 0.0f);
+	TestFalse(TEXT("not holding"), holdTrigger.IsHolding());
+
+	holdTrigger.Press(1.0f);
+	TestEqual(TEXT("no max hold time is fully charged"), holdTrigger.GetChargeFraction(1.0f, 0.0f), 1.0f);
+	TestEqual(TEXT("hold time at release"), holdTrigger.Release(1.5f), 0.5f, 1.e-4f);
+	TestEqual(TEXT("charge after release"), holdTrigger.GetChargeFraction(2.0f, 1.0f), 0.0f);
+
+	return true;
+}
+
+#endif
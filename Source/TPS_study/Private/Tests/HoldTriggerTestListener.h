@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "UObject/Object.h"
+#include "HoldTriggerTestListener.generated.h"
+
+class URangedWeaponComponent;
+
+/**
+ * record the hold trigger event of a URangedWeaponComponent, for TPS_study.Weapon.HoldTrigger
+ * the event are dynamic delegate, they can only be bound to a UFUNCTION
+ */
+UCLASS(Transient)
+class UHoldTriggerTestListener : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	int32 ReachCount = 0;
+
+	/** world time and hold time of the last OnJustReachMaxHoldTrigger */
+	float ReachWorldTime = -1.0f;
+	float ReachHoldTime = -1.0f;
+
+	int32 ReleaseCount = 0;
+
+	/** hold time of the last OnMaxFireHoldRelease */
+	float ReleaseHoldTime = -1.0f;
+
+	UFUNCTION()
+	void OnJustReachMaxHold(URangedWeaponComponent* MyComponent, const float MyCurrentHoldTime, const float MyMaxHoldTime)
+	{
+		ReachCount++;
+		ReachWorldTime = GetWorldTimeOf(MyComponent);
+		ReachHoldTime = MyCurrentHoldTime;
+	}
+
+	UFUNCTION()
+	void OnMaxHoldRelease(URangedWeaponComponent* MyComponent, const float MyCurrentHoldTime, const float MyMaxHoldTime)
+	{
+		ReleaseCount++;
+		ReleaseHoldTime = MyCurrentHoldTime;
+	}
+
+private:
+
+	static float GetWorldTimeOf(const UObject* WorldContext)
+	{
+		const UWorld* world = WorldContext ? WorldContext->GetWorld() : nullptr;
+		return world ? world->GetTimeSeconds() : -1.0f;
+	}
+};
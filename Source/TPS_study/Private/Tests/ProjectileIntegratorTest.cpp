@@ -0,0 +1,191 @@
+#include "Library/ProjectileIntegrator.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#include "Tests/TPSTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ProjectileIntegratorTest
+{
+	/** projectile arrays owned by the test, viewed by a FProjectileIntegrationStream */
+	struct FIntegrationArrays
+	{
+		TArray<float> PositionX, PositionY, PositionZ;
+		TArray<float> VelocityX, VelocityY, VelocityZ;
+		TArray<float> GravityZ;
+		TArray<float> LifeTime;
+
+		/** the same random projectiles for the same seed */
+		FIntegrationArrays(const int32 InNum, const int32 Seed)
+		{
+			FRandomStream randomStream(Seed);
+
+			for (TArray<float>* floatArray : { &PositionX, &PositionY, &PositionZ, &VelocityX, &VelocityY, &VelocityZ, &GravityZ, &LifeTime })
+			{
+				floatArray->SetNumUninitialized(InNum);
+			}
+
+			for (int32 i = 0; i < InNum; i++)
+			{
+				PositionX[i] = randomStream.FRandRange(-100000.0f, 100000.0f);
+				PositionY[i] = randomStream.FRandRange(-100000.0f, 100000.0f);
+				PositionZ[i] = randomStream.FRandRange(-1000.0f, 10000.0f);
+				VelocityX[i] = randomStream.FRandRange(-20000.0f, 20000.0f);
+				VelocityY[i] = randomStream.FRandRange(-20000.0f, 20000.0f);
+				VelocityZ[i] = randomStream.FRandRange(-5000.0f, 5000.0f);
+				GravityZ[i] = -980.0f * randomStream.FRandRange(0.0f, 2.0f);
+				LifeTime[i] = randomStream.FRandRange(1.0f, 10.0f);
+			}
+		}
+
+		FProjectileIntegrationStream GetStream()
+		{
+			FProjectileIntegrationStream stream;
+			stream.PositionX = PositionX.GetData();
+			stream.PositionY = PositionY.GetData();
+			stream.PositionZ = PositionZ.GetData();
+			stream.VelocityX = VelocityX.GetData();
+			stream.VelocityY = VelocityY.GetData();
+			stream.VelocityZ = VelocityZ.GetData();
+			stream.GravityZ = GravityZ.GetData();
+			stream.LifeTime = LifeTime.GetData();
+			stream.Num = PositionX.Num();
+
+			return stream;
+		}
+	};
+
+	static bool IsBitIdentical(const TArray<float>& A, const TArray<float>& B)
+	{
+		return A.Num() == B.Num() && FMemory::Memcmp(A.GetData(), B.GetData(), A.Num() * sizeof(float)) == 0;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProjectileIntegratorTest, "TPS_study.Projectile.Integrator",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FProjectileIntegratorTest::RunTest(const FString& Parameters)
+{
+	using namespace ProjectileIntegratorTest;
+
+	// not a multiple of 4, so the remainder of IntegrateVector is covered too
+	const int32 projectileCount = 1027;
+	const int32 seed = 0x7E57;
+
+	FIntegrationArrays scalarArrays(projectileCount, seed);
+	FIntegrationArrays vectorArrays(projectileCount, seed);
+
+	// 2 second of uneven frames, a difference in the last bit would grow with every step
+	FRandomStream frameStream(seed);
+
+	for (int32 frame = 0; frame < 240; frame++)
+	{
+		const float deltaSeconds = frameStream.FRandRange(1.0f / 144.0f, 1.0f / 15.0f);
+
+		FProjectileIntegrator::IntegrateScalar(scalarArrays.GetStream(), deltaSeconds);
+		FProjectileIntegrator::IntegrateVector(vectorArrays.GetStream(), deltaSeconds);
+	}
+
+	TestTrue(TEXT("position X bit identical"), IsBitIdentical(scalarArrays.PositionX, vectorArrays.PositionX));
+	TestTrue(TEXT("position Y bit identical"), IsBitIdentical(scalarArrays.PositionY, vectorArrays.PositionY));
+	TestTrue(TEXT("position Z bit identical"), IsBitIdentical(scalarArrays.PositionZ, vectorArrays.PositionZ));
+	TestTrue(TEXT("velocity Z bit identical"), IsBitIdentical(scalarArrays.VelocityZ, vectorArrays.VelocityZ));
+	TestTrue(TEXT("life time bit identical"), IsBitIdentical(scalarArrays.LifeTime, vectorArrays.LifeTime));
+
+	// X and Y velocity are read only
+	const FIntegrationArrays startArrays(projectileCount, seed);
+	TestTrue(TEXT("velocity X untouched"), IsBitIdentical(startArrays.VelocityX, vectorArrays.VelocityX));
+	TestTrue(TEXT("velocity Y untouched"), IsBitIdentical(startArrays.VelocityY, vectorArrays.VelocityY));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProjectileIntegratorBenchmark, "TPS_study.Benchmark.ProjectileIntegrator",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FProjectileIntegratorBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace ProjectileIntegratorTest;
+
+	const int32 projectileCount = 5000;
+	const int32 sampleCount = 50;
+	const int32 stepsPerSample = 100;
+	const float deltaSeconds = 1.0f / 60.0f;
+
+	FIntegrationArrays scalarArrays(projectileCount, 1);
+	FIntegrationArrays vectorArrays(projectileCount, 1);
+
+	TArray<double> scalarTimes;
+	TArray<double> vectorTimes;
+
+	for (int32 sample = 0; sample < sampleCount; sample++)
+	{
+		double startTime = FPlatformTime::Seconds();
+		for (int32 step = 0; step < stepsPerSample; step++)
+		{
+			FProjectileIntegrator::IntegrateScalar(scalarArrays.GetStream(), deltaSeconds);
+		}
+		scalarTimes.Add((FPlatformTime::Seconds() - startTime) / stepsPerSample);
+
+		startTime = FPlatformTime::Seconds();
+		for (int32 step = 0; step < stepsPerSample; step++)
+		{
+			FProjectileIntegrator::IntegrateVector(vectorArrays.GetStream(), deltaSeconds);
+		}
+		vectorTimes.Add((FPlatformTime::Seconds() - startTime) / stepsPerSample);
+	}
+
+	// what every ATPS_Projectile paid before the simulation: one movement component tick each (no collision here)
+	const int32 componentCount = 1000;
+	const int32 componentFrameCount = 60;
+
+	FTPSTestWorld testWorld;
+	TArray<UProjectileMovementComponent*> movementComponents;
+
+	for (int32 i = 0; i < componentCount; i++)
+	{
+		AActor* actor = testWorld.World->SpawnActor<AActor>();
+		USceneComponent* rootComponent = NewObject<USceneComponent>(actor);
+		actor->SetRootComponent(rootComponent);
+		rootComponent->RegisterComponent();
+
+		UProjectileMovementComponent* movementComponent = NewObject<UProjectileMovementComponent>(actor);
+		movementComponent->SetUpdatedComponent(rootComponent);
+		movementComponent->Velocity = FVector(vectorArrays.VelocityX[i], vectorArrays.VelocityY[i], vectorArrays.VelocityZ[i]);
+		movementComponent->ProjectileGravityScale = 1.0f;
+		movementComponent->RegisterComponent();
+
+		// ticked by hand below only
+		movementComponent->SetComponentTickEnabled(false);
+		movementComponents.Add(movementComponent);
+	}
+
+	TArray<double> componentTimes;
+
+	for (int32 frame = 0; frame < componentFrameCount; frame++)
+	{
+		const double startTime = FPlatformTime::Seconds();
+		for (UProjectileMovementComponent* movementComponent : movementComponents)
+		{
+			movementComponent->TickComponent(deltaSeconds, LEVELTICK_All, nullptr);
+		}
+		componentTimes.Add(FPlatformTime::Seconds() - startTime);
+	}
+
+	const double scalarTime = FTPSTestWorld::GetMedian(scalarTimes);
+	const double vectorTime = FTPSTestWorld::GetMedian(vectorTimes);
+	const double componentTime = FTPSTestWorld::GetMedian(componentTimes);
+
+	// timing depends on the machine and the build, reported only
+	AddInfo(FString::Printf(TEXT("scalar: %.2f ns per projectile"), scalarTime * 1.e9 / projectileCount));
+	AddInfo(FString::Printf(TEXT("vector: %.2f ns per projectile, %.2fx the scalar path"), vectorTime * 1.e9 / projectileCount, scalarTime / FMath::Max(vectorTime, 1.e-12)));
+	AddInfo(FString::Printf(TEXT("UProjectileMovementComponent: %.2f ns per projectile, %.1fx the vector path"),
+		componentTime * 1.e9 / componentCount, (componentTime / componentCount) / FMath::Max(vectorTime / projectileCount, 1.e-15)));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,78 @@
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+#include "Actor/TPS_ProjectileSimulation.h"
+#include "Library/TPSFunctionLibrary.h"
+#include "Tests/TPSTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProjectileSimulationBenchmark, "TPS_study.Benchmark.ProjectileSimulation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FProjectileSimulationBenchmark::RunTest(const FString& Parameters)
+{
+	// target: 5000 projectile in flight under 1 ms of game thread per frame
+	const int32 projectileCount = 5000;
+	const int32 frameCount = 120;
+	const float frameTime = 1.0f / 60.0f;
+
+	IConsoleVariable* collisionMode = IConsoleManager::Get().FindConsoleVariable(TEXT("TPS.Projectile.CollisionMode"));
+	if (!TestNotNull(TEXT("TPS.Projectile.CollisionMode"), collisionMode)) return false;
+
+	// sync sweep, then async sweep
+	for (const int32 forcedCollisionMode : { 0, 1 })
+	{
+		collisionMode->Set(forcedCollisionMode, ECVF_SetByCode);
+
+		FTPSTestWorld testWorld;
+
+		ATPS_ProjectileSimulation* projectileSimulation = UTPSFunctionLibrary::GetWorldManager<ATPS_ProjectileSimulation>(testWorld.World);
+		if (!TestNotNull(TEXT("projectile simulation"), projectileSimulation)) break;
+
+		// what the world cost without projectile, taken off the frame below
+		TArray<double> emptyFrameTimes;
+		for (int32 frame = 0; frame < frameCount; frame++)
+		{
+			const double startTime = FPlatformTime::Seconds();
+			testWorld.Tick(frameTime);
+			emptyFrameTimes.Add(FPlatformTime::Seconds() - startTime);
+		}
+
+		// live for the whole run, nothing is retired or added while measuring
+		FProjectileSpec projectileSpec = FTPSTestWorld::MakeProjectileSpec(5000.0f, 60.0f, 0.0f);
+		projectileSpec.GravityScale = 1.0f;
+
+		for (int32 i = 0; i < projectileCount; i++)
+		{
+			// spread on a half sphere, so they do not all follow the same path
+			const FRotator direction(FMath::Fmod(i * 0.37f, 60.0f), i * 7.0f, 0.0f);
+			projectileSimulation->AddProjectile(projectileSpec, nullptr, FTransform(direction, FVector(0.0f, 0.0f, 1000.0f)));
+		}
+
+		TArray<double> frameTimes;
+		for (int32 frame = 0; frame < frameCount; frame++)
+		{
+			const double startTime = FPlatformTime::Seconds();
+			testWorld.Tick(frameTime);
+			frameTimes.Add(FPlatformTime::Seconds() - startTime);
+		}
+
+		TestEqual(TEXT("every projectile still in flight"), projectileSimulation->GetProjectileCount(), projectileCount);
+
+		const double emptyFrameTime = FTPSTestWorld::GetMedian(emptyFrameTimes);
+		const double frameTimeWithProjectiles = FTPSTestWorld::GetMedian(frameTimes);
+		const double simulationTime = FMath::Max(frameTimeWithProjectiles - emptyFrameTime, 0.0);
+
+		// timing depends on the machine and the build, reported only
+		AddInfo(FString::Printf(TEXT("%s sweep: %i projectiles, simulation %.3f ms per frame (target 1 ms), %.1f ns per projectile, max frame %.3f ms"),
+			forcedCollisionMode == 1 ? TEXT("async") : TEXT("sync"), projectileCount, simulationTime * 1000.0,
+			simulationTime * 1.e9 / projectileCount, frameTimes.Last() * 1000.0));
+	}
+
+	collisionMode->Set(-1, ECVF_SetByCode);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include "Misc/AutomationTest.h"
+
+#include "Actor/TPS_ProjectileSimulation.h"
+#include "Library/TPSFunctionLibrary.h"
+#include "Tests/TPSTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProjectileSoakTest, "TPS_study.Projectile.Soak",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FProjectileSoakTest::RunTest(const FString& Parameters)
+{
+	// 10 minute of fire into an empty world, nothing is ever hit
+	const int32 frameRate = 30;
+	const int32 frameCount = 10 * 60 * frameRate;
+	const int32 framePerRound = 3;
+
+	FTPSTestWorld testWorld;
+
+	ATPS_ProjectileSimulation* projectileSimulation = UTPSFunctionLibrary::GetWorldManager<ATPS_ProjectileSimulation>(testWorld.World);
+	if (!TestNotNull(TEXT("projectile simulation"), projectileSimulation)) return false;
+
+	// one retired by the default life time of the simulation (10 second), one by its range (2 second)
+	const FProjectileSpec lifeTimeSpec = FTPSTestWorld::MakeProjectileSpec(5000.0f, 0.0f, 0.0f);
+	const FProjectileSpec rangeSpec = FTPSTestWorld::MakeProjectileSpec(10000.0f, 0.0f, 20000.0f);
+
+	// 5 round per second of each for 10 second
+	const int32 maxLiveCount = (10 * frameRate / framePerRound) / 2 + (2 * frameRate / framePerRound) / 2 + 2;
+
+	int32 firedCount = 0;
+	int32 firstHalfPeak = 0;
+	int32 secondHalfPeak = 0;
+
+	for (int32 frame = 0; frame < frameCount; frame++)
+	{
+		if (frame % framePerRound == 0)
+		{
+			// spread on a fan, so they do not all follow the same path
+			const FRotator direction(0.0f, (frame / framePerRound) * 7.0f, 0.0f);
+			const FProjectileSpec& projectileSpec = (firedCount % 2 == 0) ? lifeTimeSpec : rangeSpec;
+
+			projectileSimulation->AddProjectile(projectileSpec, nullptr, FTransform(direction, FVector(0.0f, 0.0f, 1000.0f)));
+			firedCount++;
+		}
+
+		testWorld.Tick(1.0f / frameRate);
+
+		int32& halfPeak = (frame < frameCount / 2) ? firstHalfPeak : secondHalfPeak;
+		halfPeak = FMath::Max(halfPeak, projectileSimulation->GetProjectileCount());
+	}
+
+	TestTrue(FString::Printf(TEXT("peak %i is bounded by %i"), projectileSimulation->GetPeakProjectileCount(), maxLiveCount),
+		projectileSimulation->GetPeakProjectileCount() <= maxLiveCount);
+	TestTrue(FString::Printf(TEXT("live count flatten out, second half peak %i first half peak %i"), secondHalfPeak, firstHalfPeak),
+		secondHalfPeak <= firstHalfPeak);
+	TestEqual(TEXT("every retired projectile expired"), projectileSimulation->GetExpiredCount(), firedCount - projectileSimulation->GetProjectileCount());
+	TestEqual(TEXT("out of world"), projectileSimulation->GetOutOfWorldCount(), 0);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,71 @@
+#include "Components/BoxComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+#include "Actor/TPS_ProjectileSimulation.h"
+#include "Custom/CustomCollisionChannel.h"
+#include "Library/TPSFunctionLibrary.h"
+#include "Tests/TPSTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProjectileTunnelingTest, "TPS_study.Projectile.Tunneling",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FProjectileTunnelingTest::RunTest(const FString& Parameters)
+{
+	// 8000 unit per second against a 2 unit thick enemy, at 15 fps a frame move 533 unit
+	const float speed = 8000.0f;
+	const int32 shotCount = 8;
+
+	IConsoleVariable* collisionMode = IConsoleManager::Get().FindConsoleVariable(TEXT("TPS.Projectile.CollisionMode"));
+	if (!TestNotNull(TEXT("TPS.Projectile.CollisionMode"), collisionMode)) return false;
+
+	// sync sweep, then async sweep (read one frame later)
+	for (const int32 forcedCollisionMode : { 0, 1 })
+	{
+		collisionMode->Set(forcedCollisionMode, ECVF_SetByCode);
+
+		for (const int32 frameRate : { 15, 30, 60 })
+		{
+			FTPSTestWorld testWorld;
+
+			ATPS_ProjectileSimulation* projectileSimulation = UTPSFunctionLibrary::GetWorldManager<ATPS_ProjectileSimulation>(testWorld.World);
+			if (!TestNotNull(TEXT("projectile simulation"), projectileSimulation)) break;
+
+			AActor* target = testWorld.World->SpawnActor<AActor>();
+			UBoxComponent* targetBox = NewObject<UBoxComponent>(target);
+			targetBox->SetBoxExtent(FVector(1.0f, 200.0f, 200.0f));
+			targetBox->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+			targetBox->SetCollisionObjectType(ECC_Enemy);
+			targetBox->SetCollisionResponseToAllChannels(ECR_Block);
+			target->SetRootComponent(targetBox);
+			targetBox->RegisterComponent();
+
+			const FProjectileSpec projectileSpec = FTPSTestWorld::MakeProjectileSpec(speed, 1.0f, 0.0f);
+
+			for (int32 shot = 0; shot < shotCount; shot++)
+			{
+				// a different distance each shot, so the target is crossed at a different point of the frame
+				targetBox->SetWorldLocation(FVector(1000.0f + shot * 61.0f, 0.0f, 0.0f));
+
+				projectileSimulation->AddProjectile(projectileSpec, nullptr, FTransform(FVector::ZeroVector));
+
+				for (int32 frame = 0; frame < frameRate && projectileSimulation->GetProjectileCount() > 0; frame++)
+				{
+					testWorld.Tick(1.0f / frameRate);
+				}
+			}
+
+			const FString caseName = FString::Printf(TEXT("%s sweep at %i fps"), forcedCollisionMode == 1 ? TEXT("async") : TEXT("sync"), frameRate);
+			TestEqual(caseName + TEXT(", hit"), projectileSimulation->GetHitCount(), shotCount);
+			TestEqual(caseName + TEXT(", went through"), projectileSimulation->GetExpiredCount(), 0);
+		}
+	}
+
+	collisionMode->Set(-1, ECVF_SetByCode);
+
+	return true;
+}
+
+#endif
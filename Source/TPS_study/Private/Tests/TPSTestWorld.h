@@ -0,0 +1,140 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/WorldSettings.h"
+
+#include "Actor/TPS_Projectile.h"
+#include "Character/TPShooterCharacter.h"
+#include "Component/RangedWeaponComponent.h"
+#include "Library/WeaponSpecCache.h"
+#include "Struct/TableStruct/WeaponTableStruct.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * empty game world ticked by hand, for the test that need collision, timer and world manager
+ * actor spawned in it begin play right away
+ */
+struct FTPSTestWorld
+{
+	UWorld* World;
+
+	FTPSTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+
+		FWorldContext& worldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		worldContext.SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL());
+
+		// there is no game mode to start the play
+		World->BeginPlay();
+		World->GetWorldSettings()->NotifyBeginPlay();
+	}
+
+	~FTPSTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	/** one engine frame: world tick, timer, async trace */
+	void Tick(const float DeltaSeconds)
+	{
+		GFrameCounter++;
+		World->Tick(LEVELTICK_All, DeltaSeconds);
+	}
+
+	/** median of timing samples (second), sorted in place, less noisy than the mean on a shared machine */
+	static double GetMedian(TArray<double>& Samples)
+	{
+		if (Samples.Num() == 0) return 0.0;
+
+		Samples.Sort();
+		return Samples[Samples.Num() / 2];
+	}
+
+	/**
+	 * shooter standing still at Location (no controller, no movement), WeaponTable replace the project table before its BeginPlay
+	 * bShootWithoutAiming skip the aiming transition the weapon otherwise wait for
+	 */
+	ATPShooterCharacter* SpawnShooter(UDataTable* WeaponTable, const FVector& Location, const bool bShootWithoutAiming = true)
+	{
+		const FTransform spawnTransform(Location);
+
+		ATPShooterCharacter* shooter = World->SpawnActorDeferred<ATPShooterCharacter>(ATPShooterCharacter::StaticClass(), spawnTransform,
+			nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (shooter == nullptr) return nullptr;
+
+		// protected default, set the way the blueprint would
+		URangedWeaponComponent* rangedWeapon = shooter->GetRangedWeapon();
+
+		if (UObjectProperty* weaponTableProperty = FindField<UObjectProperty>(URangedWeaponComponent::StaticClass(), TEXT("WeaponTable")))
+		{
+			weaponTableProperty->SetObjectPropertyValue_InContainer(rangedWeapon, WeaponTable);
+		}
+
+		if (UBoolProperty* shootWithoutAimingProperty = FindField<UBoolProperty>(URangedWeaponComponent::StaticClass(), TEXT("bIsAbleToShootWithoutAiming")))
+		{
+			shootWithoutAimingProperty->SetPropertyValue_InContainer(rangedWeapon, bShootWithoutAiming);
+		}
+
+		shooter->FinishSpawning(spawnTransform);
+
+		// there is no floor, it would fall out of the world
+		shooter->GetCharacterMovement()->DisableMovement();
+
+		return shooter;
+	}
+
+	/** transient weapon table, one row per weapon mode ("Weapon_0", "Weapon_1"...), so the test does not depend on the content table */
+	static UDataTable* MakeWeaponTable(const TArray<FWeaponMode>& WeaponModes)
+	{
+		UDataTable* weaponTable = NewObject<UDataTable>(GetTransientPackage(), NAME_None, RF_Transient);
+		weaponTable->RowStruct = FWeaponModeCompact::StaticStruct();
+
+		for (int32 i = 0; i < WeaponModes.Num(); i++)
+		{
+			FWeaponModeCompact weaponRow;
+			weaponRow.WeaponMode = WeaponModes[i];
+			weaponTable->AddRow(*FString::Printf(TEXT("Weapon_%i"), i), weaponRow);
+		}
+
+		return weaponTable;
+	}
+
+	/** weapon without cost, particle or sound, FireRateAndOther = { FireRate, MaxHoldTime } */
+	static FWeaponMode MakeWeaponMode(const ETriggerMechanism Trigger, const float FireRate, const float MaxHoldTime, const float Speed, const float MaxLifeTime)
+	{
+		FWeaponMode weaponMode;
+		weaponMode.Weapon.Trigger = Trigger;
+		weaponMode.Weapon.WeaponCost = EWeaponCost::Nothing;
+		weaponMode.Weapon.FireRateAndOther = { FireRate, MaxHoldTime };
+		weaponMode.Projectile.ProjectileData.SpeedxGravityxScale = { Speed, 0.0f, 1.0f };
+		weaponMode.Projectile.ProjectileData.MaxLifeTime = MaxLifeTime;
+
+		return weaponMode;
+	}
+
+	/** simulated projectile of the default class, no particle or sound asset */
+	static FProjectileSpec MakeProjectileSpec(const float Speed, const float MaxLifeTime, const float MaxRange)
+	{
+		FProjectileSpec projectileSpec;
+		projectileSpec.Speed = Speed;
+		projectileSpec.GravityScale = 0.0f;
+		projectileSpec.ParticleScale = 1.0f;
+		projectileSpec.MaxLifeTime = MaxLifeTime;
+		projectileSpec.MaxRange = MaxRange;
+		projectileSpec.bIsHitscan = false;
+		projectileSpec.ProjectileClass = ATPS_Projectile::StaticClass();
+		FWeaponSpecCache::ClearProjectileAssets(projectileSpec);
+
+		return projectileSpec;
+	}
+};
+
+#endif
@@ -0,0 +1,41 @@
+#include "Library/WeaponSpecCache.h"
+#include "Engine/CurveTable.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponSpinUpTest, "TPS_study.Weapon.SpinUp",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FWeaponSpinUpTest::RunTest(const FString& Parameters)
+{
+	// imported from SourceFiles/FloatTable/AssaultRifleRPM.csv, round per second at alpha 0 and 1
+	const UCurveTable* rpmTable = LoadObject<UCurveTable>(nullptr, TEXT("/Game/DataAsset/Projectile/AssaultRifleRPM.AssaultRifleRPM"));
+	if (!TestNotNull(TEXT("AssaultRifleRPM curve table"), rpmTable)) return false;
+
+	FWeaponSpec weaponSpec;
+	weaponSpec.FireRate = 0.3f;
+
+	TestTrue(TEXT("AssaultRifle has a spin up"), FWeaponSpecCache::BakeSpinUp(rpmTable, TEXT("AssaultRifle"), weaponSpec));
+	TestTrue(TEXT("AssaultRifle bHasSpinUp"), weaponSpec.bHasSpinUp);
+	TestEqual(TEXT("AssaultRifle at alpha 0"), weaponSpec.GetRoundsPerSecond(0.0f), 10.0f, 1.e-3f);
+	TestEqual(TEXT("AssaultRifle at alpha 0.5"), weaponSpec.GetRoundsPerSecond(0.5f), 12.5f, 1.e-3f);
+	TestEqual(TEXT("AssaultRifle at alpha 1"), weaponSpec.GetRoundsPerSecond(1.0f), 15.0f, 1.e-3f);
+	TestEqual(TEXT("AssaultRifle past alpha 1 is clamped"), weaponSpec.GetRoundsPerSecond(2.0f), 15.0f, 1.e-3f);
+	TestEqual(TEXT("AssaultRifle interval at alpha 1"), weaponSpec.GetFireInterval(1.0f), 1.0f / 15.0f, 1.e-4f);
+
+	TestTrue(TEXT("AssaultRifle B has a spin up"), FWeaponSpecCache::BakeSpinUp(rpmTable, TEXT("AssaultRifle B"), weaponSpec));
+	TestEqual(TEXT("AssaultRifle B at alpha 0.5"), weaponSpec.GetRoundsPerSecond(0.5f), 17.0f, 1.e-3f);
+
+	// a weapon without a row keep its constant fire rate
+	TestFalse(TEXT("no row has no spin up"), FWeaponSpecCache::BakeSpinUp(rpmTable, TEXT("NoSuchWeapon"), weaponSpec));
+	TestFalse(TEXT("no row bHasSpinUp"), weaponSpec.bHasSpinUp);
+	TestEqual(TEXT("no row interval"), weaponSpec.GetFireInterval(0.5f), 0.3f);
+	TestEqual(TEXT("no row round per second"), weaponSpec.GetRoundsPerSecond(0.5f), 1.0f / 0.3f, 1.e-4f);
+
+	TestFalse(TEXT("no RPM table has no spin up"), FWeaponSpecCache::BakeSpinUp(nullptr, TEXT("AssaultRifle"), weaponSpec));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,90 @@
+#include "Misc/AutomationTest.h"
+
+#include "Tests/TPSTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponSwitchBenchmark, "TPS_study.Benchmark.WeaponSwitch",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FWeaponSwitchBenchmark::RunTest(const FString& Parameters)
+{
+	// 1000 character cycling weapon every frame
+	const int32 shooterCount = 1000;
+	const int32 frameCount = 60;
+	const float frameTime = 1.0f / 60.0f;
+
+	TArray<FWeaponMode> weaponModes;
+	for (const ETriggerMechanism trigger : { ETriggerMechanism::PressTrigger, ETriggerMechanism::AutomaticTrigger, ETriggerMechanism::ReleaseTrigger, ETriggerMechanism::OnePressAutoTrigger })
+	{
+		FWeaponMode weaponMode = FTPSTestWorld::MakeWeaponMode(trigger, 0.1f, 1.0f, 8000.0f, 1.0f);
+		weaponMode.Weapon.SocketName = { TEXT("Muzzle_01"), TEXT("Muzzle_02") };
+		weaponModes.Add(weaponMode);
+	}
+
+	UDataTable* weaponTable = FTPSTestWorld::MakeWeaponTable(weaponModes);
+
+	FTPSTestWorld testWorld;
+	TArray<URangedWeaponComponent*> rangedWeapons;
+
+	for (int32 i = 0; i < shooterCount; i++)
+	{
+		ATPShooterCharacter* shooter = testWorld.SpawnShooter(weaponTable, FVector((i % 32) * 200.0f, (i / 32) * 200.0f, 0.0f));
+		if (!TestNotNull(TEXT("shooter"), shooter)) return false;
+
+		rangedWeapons.Add(shooter->GetRangedWeapon());
+	}
+
+	// after: the shared spec is swapped by pointer
+	TArray<double> specTimes;
+
+	for (int32 frame = 0; frame < frameCount; frame++)
+	{
+		const double startTime = FPlatformTime::Seconds();
+		for (URangedWeaponComponent* rangedWeapon : rangedWeapons)
+		{
+			rangedWeapon->SetWeaponIndexWithMouseWheel(true);
+		}
+		specTimes.Add(FPlatformTime::Seconds() - startTime);
+
+		testWorld.Tick(frameTime);
+	}
+
+	TestEqual(TEXT("weapon index after the cycle"), rangedWeapons[0]->GetWeaponIndex(), frameCount % weaponModes.Num());
+
+	// before: FindRow by name and a FWeaponMode copy per character (what SetWeaponMode did)
+	const TArray<FName> rowNames = weaponTable->GetRowNames();
+	TArray<FWeaponMode> currentWeaponModes;
+	currentWeaponModes.SetNum(shooterCount);
+
+	TArray<double> findRowTimes;
+
+	for (int32 frame = 0; frame < frameCount; frame++)
+	{
+		const FName rowName = rowNames[(frame + 1) % rowNames.Num()];
+
+		const double startTime = FPlatformTime::Seconds();
+		for (FWeaponMode& currentWeaponMode : currentWeaponModes)
+		{
+			if (const FWeaponModeCompact* weaponRow = weaponTable->FindRow<FWeaponModeCompact>(rowName, TEXT("WeaponSwitchBenchmark")))
+			{
+				currentWeaponMode = weaponRow->WeaponMode;
+			}
+		}
+		findRowTimes.Add(FPlatformTime::Seconds() - startTime);
+
+		testWorld.Tick(frameTime);
+	}
+
+	const double specTime = FTPSTestWorld::GetMedian(specTimes);
+	const double findRowTime = FTPSTestWorld::GetMedian(findRowTimes);
+
+	// timing depends on the machine and the build, reported only
+	AddInfo(FString::Printf(TEXT("before (FindRow + FWeaponMode copy): %.3f ms per frame, %.1f ns per switch"), findRowTime * 1000.0, findRowTime * 1.e9 / shooterCount));
+	AddInfo(FString::Printf(TEXT("after (SetWeaponIndexWithMouseWheel): %.3f ms per frame, %.1f ns per switch"), specTime * 1000.0, specTime * 1.e9 / shooterCount));
+	AddInfo(TEXT("after include what the component do on switch besides the row lookup: stop the fire loop, equip load request, pre-warm timer, muzzle socket"));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "TPS_FXManager.generated.h"
+
+class UParticleSystem;
+class UParticleSystemComponent;
+class USoundBase;
+
+/** pooled particle system components of one template */
+USTRUCT()
+struct FFXPoolList
+{
+	GENERATED_BODY();
+
+	UPROPERTY()
+	TArray<UParticleSystemComponent*> FreeComponents;
+
+	/** all component created for this template, free or playing */
+	int32 Size;
+
+	/** playing right now */
+	int32 Live;
+
+	int32 Hit;
+	int32 Miss;
+	int32 Culled;
+};
+
+//=============================================================================
+/**
+ * ATPS_FXManager play muzzle/hit particle with pooled components
+ * one per world, get it with UTPSFunctionLibrary::GetWorldManager
+ * a finished component go back to the pool of its template instead of being destroyed,
+ * FX too far from every local view or over budget are not played at all
+ * impacts are queued and played once per frame, merged by template and spatial cell
+ */
+UCLASS(NotPlaceable, Transient)
+class TPS_STUDY_API ATPS_FXManager : public AInfo
+{
+	GENERATED_BODY()
+
+//===========================================================================
+public:
+//===========================================================================
+
+	ATPS_FXManager();
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	/** play Template at SpawnTransform, nullptr if culled (distance or budget) */
+	UParticleSystemComponent* SpawnEmitter(UParticleSystem* Template, const FTransform& SpawnTransform);
+
+	/**
+	 * play at the end of the frame, impacts with the same template and sound in the same cell
+	 * become one burst (ImpactCountParameter = impact count) and one sound
+	 */
+	void QueueImpact(UParticleSystem* Template, USoundBase* Sound, const FTransform& ImpactTransform);
+
+	/** make sure at least InCount components of this template exist */
+	void PrewarmEmitter(UParticleSystem* Template, const int32 InCount);
+
+	/** destroy the free component of Template and forget its pool, a playing one is destroyed when it finish */
+	void PurgeEmitter(UParticleSystem* Template);
+
+	//=================
+	// Getter (public):
+	//=================
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "FX Manager")
+	int32 GetLiveCount() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "FX Manager")
+	int32 GetPoolHitCount() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "FX Manager")
+	int32 GetPoolMissCount() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "FX Manager")
+	int32 GetCulledCount() const;
+
+	/** impact not played on its own because it was merged into another of the same frame */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "FX Manager")
+	int32 GetMergedImpactCount() const;
+
+//===========================================================================
+protected:
+//===========================================================================
+
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** FX of one template playing at the same time, more are culled */
+	UPROPERTY(EditDefaultsOnly, Category = "FX Manager")
+	int32 MaxLivePerTemplate = 32;
+
+	/** FX of every template playing at the same time, more are culled */
+	UPROPERTY(EditDefaultsOnly, Category = "FX Manager")
+	int32 MaxLiveTotal = 256;
+
+	/** FX further than this from every local view are culled, 0 = no distance cull */
+	UPROPERTY(EditDefaultsOnly, Category = "FX Manager")
+	float CullDistance = 10000.0f;
+
+	/** size of the cell same frame impacts are merged in */
+	UPROPERTY(EditDefaultsOnly, Category = "FX Manager")
+	float ImpactCellSize = 100.0f;
+
+	/** float instance parameter set to the merged impact count, bind the spawn count of the hit particle to it */
+	UPROPERTY(EditDefaultsOnly, Category = "FX Manager")
+	FName ImpactCountParameter = TEXT("ImpactCount");
+
+//===========================================================================
+private:
+//===========================================================================
+
+	UPROPERTY()
+	TMap<UParticleSystem*, FFXPoolList> Pools;
+
+	int32 TotalSize;
+	int32 TotalLive;
+	int32 TotalHit;
+	int32 TotalMiss;
+	int32 TotalCulled;
+	int32 TotalMerged;
+
+	struct FImpactKey
+	{
+		UParticleSystem* Template;
+		USoundBase* Sound;
+		FIntVector Cell;
+
+		FORCEINLINE bool operator==(const FImpactKey& Other) const
+		{
+			return Template == Other.Template && Sound == Other.Sound && Cell == Other.Cell;
+		}
+
+		friend FORCEINLINE uint32 GetTypeHash(const FImpactKey& Key)
+		{
+			return HashCombine(HashCombine(PointerHash(Key.Template), PointerHash(Key.Sound)), GetTypeHash(Key.Cell));
+		}
+	};
+
+	struct FImpactGroup
+	{
+		UParticleSystem* Template;
+		USoundBase* Sound;
+		FTransform Transform;
+		FVector LocationSum;
+		int32 Count;
+	};
+
+	/** impacts of this frame, reset (not freed) after every flush */
+	TArray<FImpactGroup> ImpactGroups;
+	TMap<FImpactKey, int32> ImpactGroupIndices;
+
+	void FlushImpacts();
+
+	/** local view location, gathered once per frame */
+	TArray<FVector> ViewLocations;
+	uint64 ViewLocationFrame = MAX_uint64;
+
+	bool IsInViewDistance(const FVector& Location);
+
+	UParticleSystemComponent* CreatePooledEmitter(UParticleSystem* Template, FFXPoolList& PoolList);
+
+	/** the pool of a released weapon bundle (FProjectileAssetStreamer) would keep its particle loaded */
+	FDelegateHandle AssetsReleasedHandle;
+	void OnProjectileAssetsReleased(const TSet<UObject*>& ReleasedObjects);
+
+	UFUNCTION()
+	void OnEmitterFinished(UParticleSystemComponent* FinishedComponent);
+};
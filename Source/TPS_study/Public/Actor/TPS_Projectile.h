@@ -5,14 +5,26 @@
 #include "GameFramework/Actor.h"
 #include "TPSFunctionLibrary.h"
 #include "AmmoAndEnergyComponent.h"
+#include "Enum/ProjectileEnum.h"
 #include "TPS_Projectile.generated.h"
 
-class UProjectileMovementComponent;
 class USphereComponent;
+class UParticleSystem;
 class UParticleSystemComponent;
 class UPrimitiveComponent;
-
-
+class ATPS_FXManager;
+class ATPS_ProjectilePool;
+struct FHitResponse;
+struct FHitResponseTable;
+struct FProjectileSpec;
+
+
+/**
+ * ATPS_Projectile is the visual of a projectile
+ * movement and collision are simulated by ATPS_ProjectileSimulation,
+ * which only materialize this actor (from ATPS_ProjectilePool) when it is needed
+ * CollisionComp is kept as the collision setting (radius, object type, response) of the class
+ */
 UCLASS()
 class TPS_STUDY_API ATPS_Projectile : public AActor
 {
@@ -21,12 +33,37 @@ class TPS_STUDY_API ATPS_Projectile : public AActor
 public:	
 	ATPS_Projectile();
 
-	void SetUpProjectile(FProjectile MyProjectile, APawn* InInstigator);
+	/** re-arm a pooled projectile, replace the old SetUpProjectile + BeginPlay path */
+	void ActivateProjectile(const FProjectileSpec& MyProjectile, APawn* InInstigator, const FTransform& SpawnTransform);
+
+	/** hide the projectile, so it can wait in the pool */
+	void DeactivateProjectile();
+
+	bool IsProjectileActive() const;
+
+	/**
+	 * a visible trail is a pooled component of the FXManager attached to this projectile,
+	 * set from the projectile significance, projectile without trail never have one
+	 */
+	void SetTrailVisible(const bool bInVisible);
+
+	void SetOwningPool(ATPS_ProjectilePool* InPool);
+
+	FORCEINLINE USphereComponent* GetCollisionComp() const { return CollisionComp; }
+
+	FORCEINLINE EProjectileCollisionMode GetCollisionMode() const { return CollisionMode; }
+
+	/** particle are played through the pooled FXManager, the muzzle sound is played by URangedWeaponComponent once per round */
+	static void SpawnMuzzleEffect(ATPS_FXManager* FXManager, const UProjectileParticleDataAsset* InParticleObject, const FTransform& MuzzleTransform);
+
+	/** InResponse come from FHitResponseTable::Resolve */
+	static void SpawnHitEffect(ATPS_FXManager* FXManager, const FHitResponse& InResponse, const FTransform& HitTransform);
 
 	//void SpawnFX(TArray<UParticleSystem*> MyParticle, USoundBase* MySoundEffect, FTransform MyTransform, float MyScaleEmitter);
 
 	//void SpawnFX(UParticleSystem* MyParticle, USoundBase* MySoundEffect, FTransform MyTransform, float MyScaleEmitter);
 
+	/** return to the owning pool, or destroy if not pooled */
 	void DestroySelf();
 
 	virtual void NotifyHit(UPrimitiveComponent* MyComp, AActor* Other, UPrimitiveComponent* OtherComp, bool bSelfMoved, FVector HitLocation, FVector HitNormal, FVector NormalImpulse, const FHitResult& Hit) override;
@@ -47,20 +84,32 @@ protected:
 
 	UProjectileSoundDataAsset* ProjectileSoundObject;
 
-	FProjectileData ProjectileData;
+	TSharedPtr<const FHitResponseTable> HitResponses;
+
+	/** sync or batched async sweep, for this projectile class */
+	UPROPERTY(EditDefaultsOnly, Category = Projectile)
+	EProjectileCollisionMode CollisionMode = EProjectileCollisionMode::Sync;
 
 private:
 
-	FTimerHandle TimerDestroy;
+	bool bIsProjectileActive;
+
+	bool bIsTrailVisible;
+
+	/** FProjectileParticle::TrailParticle[0], nullptr if the data asset has none */
+	UParticleSystem* TrailTemplate;
+
+	UPROPERTY(Transient)
+	UParticleSystemComponent* TrailComponent;
+
+	void ReleaseTrail();
+
+	ATPS_ProjectilePool* OwningPool;
+
+	ATPS_FXManager* FXManager;
 
 	//TArray<UParticleSystem>
 	
-	UPROPERTY(VisibleDefaultsOnly, Category = Projectile)
-	UProjectileMovementComponent* MovementComp;
-
 	UPROPERTY(VisibleDefaultsOnly, Category = Projectile)
 	USphereComponent* CollisionComp;
-
-	UPROPERTY(VisibleDefaultsOnly, Category = Projectile)
-	UParticleSystemComponent* ProjectileTrailParticle;
 };
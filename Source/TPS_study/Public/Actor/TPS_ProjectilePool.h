@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "TPS_ProjectilePool.generated.h"
+
+class ATPS_Projectile;
+class APawn;
+struct FProjectileSpec;
+
+/** pooled instances of one projectile class */
+USTRUCT()
+struct FProjectilePoolList
+{
+	GENERATED_BODY();
+
+	UPROPERTY()
+	TArray<ATPS_Projectile*> FreeProjectiles;
+
+	/** all instance created for this class, free or in use */
+	int32 Size;
+
+	int32 InUse;
+
+	int32 HighWaterMark;
+
+	/** acquire that find no free instance and have to spawn one */
+	int32 Miss;
+};
+
+//=============================================================================
+/**
+ * ATPS_ProjectilePool keep ATPS_Projectile actors alive between shots
+ * one per world, get it with UTPSFunctionLibrary::GetWorldManager
+ * instances are pre-warmed per projectile class,
+ * handed out on fire and returned on hit/timeout instead of destroyed
+ */
+UCLASS(NotPlaceable, Transient)
+class TPS_STUDY_API ATPS_ProjectilePool : public AInfo
+{
+	GENERATED_BODY()
+
+//===========================================================================
+public:
+//===========================================================================
+
+	ATPS_ProjectilePool();
+
+	/** take a free projectile (spawn one if the pool is empty) and re-arm it */
+	ATPS_Projectile* AcquireProjectile(const FProjectileSpec& MyProjectile, APawn* InInstigator, const FTransform& SpawnTransform);
+
+	/** deactivate the projectile and put it back in the pool */
+	void ReleaseProjectile(ATPS_Projectile* MyProjectile);
+
+	/** make sure at least InCount instances of this class exist */
+	void PrewarmProjectile(TSubclassOf<ATPS_Projectile> ProjectileClass, const int32 InCount);
+
+	/** create the pool of this class with PrewarmCount instances, what its first AcquireProjectile would do, nothing if it exist */
+	void InitProjectileClass(TSubclassOf<ATPS_Projectile> ProjectileClass);
+
+	//=================
+	// Getter (public):
+	//=================
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Projectile Pool")
+	int32 GetPoolSize() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Projectile Pool")
+	int32 GetHighWaterMark() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Projectile Pool")
+	int32 GetMissCount() const;
+
+//===========================================================================
+protected:
+//===========================================================================
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** instances created the first time a projectile class is used */
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile Pool")
+	int32 PrewarmCount = 32;
+
+//===========================================================================
+private:
+//===========================================================================
+
+	UPROPERTY()
+	TMap<UClass*, FProjectilePoolList> Pools;
+
+	int32 TotalSize;
+	int32 TotalInUse;
+	int32 TotalHighWaterMark;
+	int32 TotalMiss;
+
+	FProjectilePoolList& GetPoolList(UClass* ProjectileClass);
+	ATPS_Projectile* SpawnPooledProjectile(UClass* ProjectileClass, FProjectilePoolList& PoolList);
+};
@@ -0,0 +1,305 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "CollisionQueryParams.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+#include "Enum/ProjectileEnum.h"
+#include "TPS_ProjectileSimulation.generated.h"
+
+class APawn;
+class ATPS_FXManager;
+class ATPS_Projectile;
+class ATPS_ProjectilePool;
+class UParticleSystemComponent;
+class UProjectileParticleDataAsset;
+class UProjectileSoundDataAsset;
+struct FHitResponseTable;
+struct FProjectileSpec;
+
+/**
+ * every live projectile, structure of arrays
+ * the same index in every array is one projectile
+ * removal swap the last projectile in, so index is not stable across frame
+ */
+struct TPS_STUDY_API FProjectileSimulationData
+{
+	TArray<float> PositionX;
+	TArray<float> PositionY;
+	TArray<float> PositionZ;
+
+	TArray<float> VelocityX;
+	TArray<float> VelocityY;
+	TArray<float> VelocityZ;
+
+	/** world gravity * FProjectileData::SpeedxGravityxScale[1] */
+	TArray<float> GravityZ;
+
+	/** remaining life time in second, max range is folded in when the projectile is added */
+	TArray<float> LifeTime;
+
+	TArray<float> Radius;
+	TArray<float> ParticleScale;
+
+	/** start of the next sweep, the position at the last sweep (or the muzzle) */
+	TArray<float> SweepStartX;
+	TArray<float> SweepStartY;
+	TArray<float> SweepStartZ;
+
+	/** EProjectileSignificance */
+	TArray<uint8> Significance;
+
+	/** given when the projectile is added, stagger its update frame (the index move on removal) */
+	TArray<uint32> UpdatePhase;
+
+	/** index in ATPS_ProjectileSimulation::ClassInfos */
+	TArray<int32> ClassIndex;
+
+	/** async sweep issued last frame, invalid for sync projectile */
+	TArray<FTraceHandle> TraceHandles;
+
+	/** start of the segment of TraceHandles (its end is SweepStart), swept again synchronously if the result is late */
+	TArray<float> AsyncSweepStartX;
+	TArray<float> AsyncSweepStartY;
+	TArray<float> AsyncSweepStartZ;
+
+	TArray<TWeakObjectPtr<APawn>> Instigators;
+	TArray<UProjectileParticleDataAsset*> ParticleObjects;
+	TArray<UProjectileSoundDataAsset*> SoundObjects;
+
+	/** shared, from FProjectileSpec::HitResponses */
+	TArray<TSharedPtr<const FHitResponseTable>> HitResponses;
+
+	/** materialized actor, nullptr if the projectile has no visual */
+	TArray<ATPS_Projectile*> Visuals;
+
+	FORCEINLINE int32 Num() const { return PositionX.Num(); }
+
+	void Reserve(const int32 InNum);
+
+	/** add one uninitialized projectile and return its index */
+	int32 Add();
+
+	void RemoveAtSwap(const int32 Index);
+
+	void Empty();
+};
+
+//=============================================================================
+/**
+ * ATPS_ProjectileSimulation move and collide every projectile of the world
+ * in one pass per frame, instead of one UProjectileMovementComponent per actor
+ * one per world, get it with UTPSFunctionLibrary::GetWorldManager
+ */
+UCLASS(NotPlaceable, Transient)
+class TPS_STUDY_API ATPS_ProjectileSimulation : public AInfo
+{
+	GENERATED_BODY()
+
+//===========================================================================
+public:
+//===========================================================================
+
+	ATPS_ProjectileSimulation();
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	/**
+	 * start simulating a new projectile from the muzzle transform
+	 * TimeOffset (second) is how late the round is fired, it start that far along its trajectory
+	 * and the segment from the muzzle is still swept next frame
+	 */
+	void AddProjectile(const FProjectileSpec& MyProjectile, APawn* InInstigator, const FTransform& SpawnTransform, const float TimeOffset = 0.0f);
+
+	/**
+	 * do now what the first AddProjectile of this spec would do: read its class default,
+	 * fill the projectile pool of its class and the FX pool of its muzzle, trail and hit particle
+	 * nothing for the FX if the asset of the spec are not loaded yet
+	 */
+	void PrewarmProjectile(const FProjectileSpec& MyProjectile);
+
+	/** keep the data asset of projectile in flight, their weapon bundle can be released by FProjectileAssetStreamer */
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+	//=================
+	// Getter (public):
+	//=================
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Projectile Simulation")
+	int32 GetProjectileCount() const;
+
+	/** most projectile live at once since BeginPlay, a soak run should see it flatten out */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Projectile Simulation")
+	int32 GetPeakProjectileCount() const;
+
+	/** simulated projectile retired since BeginPlay by a hit, hitscan are not counted */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Projectile Simulation")
+	int32 GetHitCount() const;
+
+	/** hitscan impact played since BeginPlay that hit something, GetHitCount of the simulated path */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Projectile Simulation")
+	int32 GetHitscanHitCount() const;
+
+	/** projectile retired since BeginPlay at the end of their life time or range */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Projectile Simulation")
+	int32 GetExpiredCount() const;
+
+	/** projectile retired since BeginPlay below KillZ or outside the world box */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Projectile Simulation")
+	int32 GetOutOfWorldCount() const;
+
+	/** projectile in this significance bucket last frame */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Projectile Simulation")
+	int32 GetSignificanceCount(const EProjectileSignificance InSignificance) const;
+
+//===========================================================================
+protected:
+//===========================================================================
+
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** projectile that hit nothing is retired after this time (second), unless its FProjectileData has its own */
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile Simulation")
+	float MaxLifeTime = 10.0f;
+
+	/**
+	 * sync sweep of one frame is split in steps no longer than collision radius * this
+	 * each step is a continuous sweep, so the count only matter for a curved path and a precise hit
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile Simulation")
+	float SubStepLengthInRadius = 64.0f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile Simulation")
+	int32 MaxSubSteps = 8;
+
+	/** swept chords a curved hitscan path is split in, a straight one (no gravity) is one sweep */
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile Simulation")
+	int32 HitscanSegmentCount = 4;
+
+	/** vector instance parameter of the hitscan tracer set to the impact location */
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile Simulation")
+	FName TracerEndParameter = TEXT("TracerEnd");
+
+	/** closer than this to a local view is Near, wherever it is looking */
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile Significance")
+	float NearDistance = 3000.0f;
+
+	/** further than this from every local view is Far */
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile Significance")
+	float FarDistance = 10000.0f;
+
+	/** frame between two sweep and visual update, per EProjectileSignificance */
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile Significance")
+	int32 UpdateInterval[(int32)EProjectileSignificance::Max] = { 1, 2, 4, 4 };
+
+	/** pooled component created per particle of a pre-warmed projectile, see PrewarmProjectile */
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile Simulation")
+	int32 PrewarmEmitterCount = 4;
+
+	/** slot reserved up front, so firing does not grow the arrays (no allocation per shot) */
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile Simulation")
+	int32 InitialCapacity = 1024;
+
+//===========================================================================
+private:
+//===========================================================================
+
+	/** collision setting read once from the projectile class default object */
+	struct FProjectileClassInfo
+	{
+		float Radius;
+		bool bTraceComplex;
+		bool bAsyncSweep;
+		ECollisionChannel ObjectType;
+		FCollisionResponseParams ResponseParams;
+	};
+
+	struct FProjectileHit
+	{
+		int32 Index;
+		FHitResult Hit;
+	};
+
+	/** impact of a hitscan projectile, played when the projectile would have arrived */
+	struct FScheduledImpact
+	{
+		float ArrivalTime;
+		bool bHit;
+		FHitResult Hit;
+		FTransform Transform;
+		TSharedPtr<const FHitResponseTable> HitResponses;
+
+		/** owner of HitResponses, referenced until the impact is played */
+		UProjectileParticleDataAsset* ParticleObject;
+		UProjectileSoundDataAsset* SoundObject;
+
+		/** looping pooled trail, deactivated when the impact is played so it go back to the FX pool */
+		TWeakObjectPtr<UParticleSystemComponent> Tracer;
+	};
+
+	FProjectileSimulationData Projectiles;
+
+	TArray<FProjectileClassInfo> ClassInfos;
+	TMap<UClass*, int32> ClassInfoIndices;
+
+	ATPS_ProjectilePool* ProjectilePool;
+
+	ATPS_FXManager* FXManager;
+
+	// per frame scratch, kept to avoid allocation:
+	TArray<FProjectileHit> Hits;
+	TArray<int32> RetiredIndices;
+	TArray<FScheduledImpact> ScheduledImpacts;
+
+	/** local view, gathered once per frame */
+	struct FSignificanceView
+	{
+		FVector Location;
+		FVector Direction;
+	};
+
+	TArray<FSignificanceView> SignificanceViews;
+	int32 SignificanceCounts[(int32)EProjectileSignificance::Max];
+
+	/** stagger the update of projectile in the same bucket across frames */
+	FORCEINLINE bool IsUpdateFrame(const int32 Index) const
+	{
+		return (GFrameCounter + Projectiles.UpdatePhase[Index]) % FMath::Max(UpdateInterval[Projectiles.Significance[Index]], 1) == 0;
+	}
+
+	/** UpdatePhase of the next projectile added, consecutive projectile update on different frame */
+	uint32 NextUpdatePhase;
+
+	/** below the world KillZ or outside the world box, projectile there are retired without FX */
+	float KillZ;
+
+	int32 PeakProjectileCount;
+	int32 TotalHit;
+	int32 TotalHitscanHit;
+	int32 TotalExpired;
+	int32 TotalOutOfWorld;
+
+	bool IsOutOfWorld(const int32 Index) const;
+
+	int32 GetClassInfoIndex(UClass* ProjectileClass);
+
+	bool IsHitscan(const FProjectileSpec& MyProjectile) const;
+
+	/** sweep the whole path now, schedule the impact and spawn a tracer, nothing is simulated */
+	void AddHitscanProjectile(const FProjectileSpec& MyProjectile, APawn* InInstigator, const FTransform& SpawnTransform, const float TimeOffset, const float LifeTime);
+	void PlayScheduledImpacts();
+
+	void IntegrateProjectiles(const float DeltaSeconds);
+	void UpdateSignificance();
+	void SweepProjectiles();
+	void SweepSubSteps(const int32 Index, const FVector& Start, const FVector& End, const FProjectileClassInfo& ClassInfo, const FCollisionShape& Sphere, const FCollisionQueryParams& QueryParams);
+	/** read the async sweep of last frame, true if it hit, its segment is swept synchronously if the result is not ready */
+	bool ConsumeAsyncSweep(const int32 Index, const FProjectileClassInfo& ClassInfo);
+	void RetireProjectiles();
+	void UpdateVisuals();
+
+	void RetireProjectile(const int32 Index);
+};
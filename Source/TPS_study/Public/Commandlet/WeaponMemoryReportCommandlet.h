@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "WeaponMemoryReportCommandlet.generated.h"
+
+//=============================================================================
+/**
+ * load the projectile FX and sound bundle of every row of a weapon table and log their resident bytes
+ * same numbers as the TPS.Weapon.MemReport console command in game
+ * UE4Editor-Cmd.exe TPS_study -run=WeaponMemoryReport [-Table=/Game/Character/Table/WeaponTable.WeaponTable]
+ */
+UCLASS()
+class TPS_STUDY_API UWeaponMemoryReportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+//===========================================================================
+public:
+//===========================================================================
+
+	UWeaponMemoryReportCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -16,6 +16,7 @@ class USpringArmComponent;
 class UUserWidget;
 
 class URangedWeaponComponent;
+struct FAimingProfileTable;
 
 //=================
 // Aiming DELEGATE:
@@ -137,7 +138,6 @@ private:
 
 	bool bIsAimingForward;
 
-	float DeltaSecond;
 	float AimingAlpha;
 	float CurrentAimingTime;
 
@@ -146,14 +146,21 @@ private:
 
 	EAimingState AimingState;
 
-	TArray<FName> AimingNames;
-	TArray<FAimingStat> AimStats; // 0 = default, 1 = aiming, 2, 3, x extra mode
+	/** camera and movement of this character when it is not aiming, aim stat 0 */
+	FAimingStat DefaultAimStat;
 
-	FTimerHandle AimingTimerHandle;
+	/** shared by every component using the same AimingTable, row i is aim stat 1 + i, see FAimingProfileCache */
+	const FAimingProfileTable* AimingProfiles;
+
+	/** 0 = default, 1 = aiming, 2, 3, x extra mode, the default if there is no such row */
+	const FAimingStat& GetAimStat(const int32 AimStatIndex) const;
+
+	/** enter TransitioningAiming and tick until the transition end, an idle component does not tick */
+	void StartAimingTransition();
+
+	/** one frame of the transition, stop ticking when it reach aiming or not aiming */
+	void UpdateAimingTransition(const float DeltaTime);
 
-	void AimingTimerStart();
-	void ClearAndStartAimingTimer();
 	void OrientCharacter(const bool bMyCharIsAiming);
-	void ClearAndInvalidateAimingTimer(const float NewCurrentTime);
 	void TimeAiming(float InAlpha);
 };
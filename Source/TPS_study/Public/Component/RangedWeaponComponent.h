@@ -1,19 +1,28 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
 #include "Engine/DataTable.h"
+#include "WorldCollision.h"
 
 #include "Component/ComponentBase.h"
 #include "Struct/TableStruct/WeaponTableStruct.h"
+#include "Library/FireScheduler.h"
+#include "Library/HoldTrigger.h"
 #include "Library/TPSFunctionLibrary.h"
+#include "Library/WeaponSpecCache.h"
 
 #include "RangedWeaponComponent.generated.h"
 
+class UCurveTable;
 class UDataTable;
 class UAimingComponent;
 class UAmmoAndEnergyComponent;
+class ATPS_ProjectileSimulation;
+class UAudioComponent;
 class UCameraComponent;
 class UHPandMPComponent;
+class USoundBase;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSwitchWeapon, URangedWeaponComponent*, MyComponent);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFireSignature, URangedWeaponComponent*, MyComponent);
@@ -45,6 +54,8 @@ public:
 
 	URangedWeaponComponent();
 
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
 	//================
 	// Event (public):
 	//================
@@ -84,6 +95,26 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Fire")
 	ETriggerMechanism GetTriggerMechanism() const;
 
+	/** round per minute right now, follow the spin up/down of the weapon */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Fire")
+	float GetCurrentRPM() const;
+
+	/** 0 = not spinning, 1 = full spin */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Fire")
+	float GetSpinAlpha() const;
+
+	/** second the trigger of a charge weapon has been held, 0 if not charging */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Fire")
+	float GetHoldTime() const;
+
+	/** hold time / max hold time, 0 to 1, continuous (for charge UI) */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Fire")
+	float GetChargeFraction() const;
+
+	/** fire sound of this shooter playing right now (muzzle, loop and tail), for profiling */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Fire")
+	int32 GetActiveFireVoiceCount() const;
+
 	//==================================
 	// Function for Controller (public):
 	//==================================
@@ -106,6 +137,8 @@ protected:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void SetUpVariables(bool bShouldCheck)  override;
 
 	//===============================
@@ -115,8 +148,34 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Weapon", Meta = (PriorityOrder = "1"))
 	UDataTable* WeaponTable;
 
+	/**
+	 * round per second of a weapon at spin alpha 0 and 1, row name = weapon name
+	 * weapon without a row fire at FireRateAndOther[0]
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon")
+	UCurveTable* RPMTable;
+
+	/**
+	 * second after a switch before the equipped, next and previous weapon are pre-warmed
+	 * (projectile and FX pool, sound decompression), so the first shot after a switch does not hitch
+	 * negative = no pre-warm
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon")
+	float PrewarmDelay = 0.2f;
+
 	UPROPERTY(EditDefaultsOnly, Category = "Aiming")
 	bool bIsAbleToShootWithoutAiming;
+
+	/** aim trace length from the camera, the projectile aim at its end if nothing is hit */
+	UPROPERTY(EditDefaultsOnly, Category = "Aiming")
+	float AimTraceDistance = 300000.0f;
+
+	/**
+	 * trace asynchronously and aim with the result of last frame
+	 * one frame late, the first shot of a burst still trace synchronously
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Aiming")
+	bool bUseAsyncAimTrace;
 	
 //===========================================================================
 private:
@@ -131,17 +190,42 @@ private:
 	UAmmoAndEnergyComponent* AmmoComponent;
 	UHPandMPComponent* MPComponent;
 
+	ATPS_ProjectileSimulation* ProjectileSimulation;
+
 	//=======================
 	// Weapon stat (private):
 	//=======================
 
-	FWeapon CurrentWeapon;
-	FProjectile CurrentProjectile;
+	/** shared by every component using the same WeaponTable, see FWeaponSpecCache */
+	const FWeaponSpecTable* WeaponSpecs;
+
+	/** points into WeaponSpecs, swapped on weapon switch */
+	const FWeaponSpec* CurrentWeapon;
 
 	int32 WeaponIndex;
 	int32 LastWeaponIndex;
 
-	TArray<FName> WeaponNames;
+	/** WeaponSpecs->WeaponNames */
+	const TArray<FName>* WeaponNames;
+
+	FTimerHandle TimerOfPrewarm;
+
+	/** weapon already pre-warmed, its pools and sound stay warm */
+	TSet<const FWeaponSpec*> PrewarmedWeapons;
+
+	bool bIsFirstShotAfterSwitch;
+
+	/** pre-warm the equipped weapon and its neighbour in the switch cycle, one still streaming is pre-warmed when it arrive */
+	void PrewarmNeighbourWeapons();
+
+	/** the equipped weapon, the next and the previous one */
+	void GetNeighbourWeapons(TArray<const FWeaponSpec*, TInlineAllocator<3>>& OutWeapons) const;
+
+	/** false if the bundle of MyWeapon is not loaded yet */
+	bool PrewarmWeapon(const FWeaponSpec& MyWeapon);
+
+	FDelegateHandle AssetsLoadedHandle;
+	void OnProjectileAssetsLoaded(const FProjectileSpec& LoadedSpec);
 	
 	//================
 	// Fire (private):
@@ -150,7 +234,6 @@ private:
 	bool bOnePressToggle;
 	bool bMaxHoldIsReach;
 	bool bIsTriggerPressed;
-	bool bIsFireRatePassed = true;
 
 	float MaxFireHoldTime;
 
@@ -158,6 +241,26 @@ private:
 
 	void SetWeaponMesh();
 
+	/** muzzle socket resolved to a bone of WeaponInWorld when the weapon is equipped */
+	struct FResolvedMuzzle
+	{
+		/** INDEX_NONE if WeaponInWorld is not skinned or the socket is not found, GetSocketTransform is used then */
+		int32 BoneIndex;
+
+		/** socket relative to its bone */
+		FTransform LocalTransform;
+	};
+
+	FResolvedMuzzle ResolvedMuzzles[FWeaponSpec::MaxMuzzleCount];
+
+	/** world transform of every muzzle, computed once per frame on first use */
+	FTransform MuzzleTransforms[FWeaponSpec::MaxMuzzleCount];
+	uint64 MuzzleTransformFrame = MAX_uint64;
+
+	void ResolveMuzzleSockets();
+	const FTransform& GetMuzzleTransform(const int32 MuzzleIndex);
+	void UpdateMuzzleTransforms();
+
 	void SetWeaponIndex(const int32 InNumber);
 	void SetWeaponIndex(const bool isUp);
 	void SetWeaponMode(const int32 MyWeaponIndex);
@@ -165,29 +268,82 @@ private:
 	void FireStandardTrigger();
 	void FireAutomaticTrigger();
 	void FireHold();
-	float HoldTime;
-	float HoldTimeRateCount = 0.2f;
+
+	/** hold time is computed from the press timestamp, not counted by a repeating timer */
+	FHoldTrigger HoldTrigger;
 	void FireAutomaticTriggerOnePress();
 
 	void FireReleaseAfterHold();
 	bool IsWeaponAbleToFire();
+	bool IsShooterAbleToFire();
+	bool IsAutomaticFireHeld() const;
+
+	/** fire one round, TimeOffset is how late it is fired (see FFireScheduler) */
+	void FireRound(const float TimeOffset);
+	float RoundTimeOffset;
 
 	void FireProjectile();
 	void FireProjectile(const EAmmoType AmmoType);
 	void FireProjectile(const EEnergyType EnergyType);
 	void FireProjectile(int* Ammo);
 	void FireProjectile(float* Energy);
-	void SpawnProjectile(USceneComponent* WeaponInWorld, TArray<FName> MuzzleName, UWorld* MyWorld, int32 i);
+	void SpawnProjectile(const FTransform& MuzzleTransform);
 
+	/** one shot, fire exactly when the max hold time is reached */
 	FTimerHandle TimerOfHoldTrigger;
-	void CountHoldTriggerTime();
+	void ReachMaxHoldTime();
+
+	/** tick only run while an automatic trigger is held, to fire the rounds due this frame */
+	FFireScheduler FireScheduler;
+	void FireDueRounds();
 
-	FTimerHandle FireRateTimer;
-	void TimerFireRateStart();
-	void TimerFireRateReset();
+	/** spin alpha is computed from these, no tick needed to spin down */
+	float SpinAlphaAtChange;
+	float SpinChangeTime;
+	bool bIsSpinningUp;
 
-	FRotator GetNewMuzzleRotationFromLineTrace(FTransform SocketTransform);
+	void StartSpin(const bool bInSpinUp);
+	float GetFireInterval() const;
+
+	FCollisionQueryParams AimQueryParams;
+
+	/** one aim trace per frame, shared by every muzzle and every round of that frame */
+	FVector AimTargetLocation;
+	uint64 AimTargetFrame = MAX_uint64;
+	FTraceHandle AimTraceHandle;
+
+	const FVector& GetAimTargetLocation();
+
+	FRotator GetNewMuzzleRotationFromLineTrace(const FTransform& SocketTransform);
 	//void PlayFireMontage();
 
+	/** automatic fire stopped (release, toggle off, no more ammo): stop ticking and end the fire loop */
+	void StopAutomaticFire();
+
+	//======================
+	// Fire audio (private):
+	//======================
+
+	/** FireLoopSound of the weapon, one voice for a whole burst, created on first use and kept */
+	UPROPERTY()
+	UAudioComponent* FireLoopVoice;
+
+	UPROPERTY()
+	UAudioComponent* FireTailVoice;
+
+	/** MuzzleSound voices reused in turn, at most CurrentWeapon->Projectile.MaxMuzzleVoice are used */
+	UPROPERTY()
+	TArray<UAudioComponent*> MuzzleVoices;
+	int32 NextMuzzleVoice;
+
+	bool IsFireLoopWeapon() const;
+	void PlayFireSound();
+	void StopFireLoop();
+	UAudioComponent* SpawnFireVoice(USoundBase* Sound);
+
+	/** a voice keep its last sound loaded, it is cleared when the weapon bundle of that sound is released */
+	FDelegateHandle AssetsReleasedHandle;
+	void OnProjectileAssetsReleased(const TSet<UObject*>& ReleasedObjects);
+
 
 };
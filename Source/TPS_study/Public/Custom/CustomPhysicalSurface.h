@@ -0,0 +1,7 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+// name set in DefaultEngine.ini, PhysicsSettings
+#define SurfaceType_Water		EPhysicalSurface::SurfaceType1
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+//===========================================================================
+// stat TPS:
+//===========================================================================
+
+DECLARE_STATS_GROUP(TEXT("TPS"), STATGROUP_TPS, STATCAT_Advanced);
+
+//=================
+// Projectile Pool:
+//=================
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectile Pool Size"), STAT_TPS_ProjectilePoolSize, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectile Pool In Use"), STAT_TPS_ProjectilePoolInUse, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectile Pool High Water Mark"), STAT_TPS_ProjectilePoolHighWater, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectile Pool Miss"), STAT_TPS_ProjectilePoolMiss, STATGROUP_TPS, TPS_STUDY_API);
+
+//=======================
+// Projectile Simulation:
+//=======================
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Simulation"), STAT_TPS_ProjectileSimulation, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Integrate"), STAT_TPS_ProjectileIntegrate, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Collision"), STAT_TPS_ProjectileCollision, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Visual Update"), STAT_TPS_ProjectileVisual, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectile Live Count"), STAT_TPS_ProjectileLiveCount, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectile Visual Count"), STAT_TPS_ProjectileVisualCount, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectile Trail"), STAT_TPS_ProjectileTrail, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Projectile Sync Sweep"), STAT_TPS_ProjectileSyncSweep, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Projectile Async Sweep"), STAT_TPS_ProjectileAsyncSweep, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Projectile Async Sweep Late"), STAT_TPS_ProjectileAsyncSweepLate, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Hitscan"), STAT_TPS_ProjectileHitscan, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Projectile Hitscan Count"), STAT_TPS_ProjectileHitscanCount, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Significance"), STAT_TPS_ProjectileSignificance, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectile Near"), STAT_TPS_ProjectileNear, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectile Mid"), STAT_TPS_ProjectileMid, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectile Far"), STAT_TPS_ProjectileFar, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectile Hidden"), STAT_TPS_ProjectileHidden, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectile Peak Count"), STAT_TPS_ProjectilePeakCount, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Projectile Expired"), STAT_TPS_ProjectileExpired, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Projectile Out Of World"), STAT_TPS_ProjectileOutOfWorld, STATGROUP_TPS, TPS_STUDY_API);
+
+//============
+// FX Manager:
+//============
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("FX Pool Size"), STAT_TPS_FXPoolSize, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("FX Live"), STAT_TPS_FXLive, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("FX Pool Hit"), STAT_TPS_FXPoolHit, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("FX Pool Miss"), STAT_TPS_FXPoolMiss, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("FX Culled"), STAT_TPS_FXCulled, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("FX Impact Merged"), STAT_TPS_FXImpactMerged, STATGROUP_TPS, TPS_STUDY_API);
+
+//==================
+// Asset Streaming:
+//==================
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Asset Async Request"), STAT_TPS_AssetAsyncRequest, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Asset Sync Fallback"), STAT_TPS_AssetSyncFallback, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Asset Sync Load"), STAT_TPS_AssetSyncLoad, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Asset Release"), STAT_TPS_AssetRelease, STATGROUP_TPS, TPS_STUDY_API);
+
+//========
+// Aiming:
+//========
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Aiming BeginPlay"), STAT_TPS_AimingBeginPlay, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Aiming Profile Build"), STAT_TPS_AimingProfileBuild, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Aiming Tick"), STAT_TPS_AimingTick, STATGROUP_TPS, TPS_STUDY_API);
+
+//===============
+// Ranged Weapon:
+//===============
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon Switch"), STAT_TPS_WeaponSwitch, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Aim Trace Sync"), STAT_TPS_AimTraceSync, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Aim Trace Async"), STAT_TPS_AimTraceAsync, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Aim Trace Cache Hit"), STAT_TPS_AimTraceCacheHit, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Muzzle Transform"), STAT_TPS_MuzzleTransform, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Fire Voice Play"), STAT_TPS_FireVoicePlay, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Fire Voice Steal"), STAT_TPS_FireVoiceSteal, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon Prewarm"), STAT_TPS_WeaponPrewarm, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Weapon Prewarm Count"), STAT_TPS_WeaponPrewarmCount, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Fire Round"), STAT_TPS_FireRound, STATGROUP_TPS, TPS_STUDY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("First Shot After Switch"), STAT_TPS_FirstShotAfterSwitch, STATGROUP_TPS, TPS_STUDY_API);
@@ -9,10 +9,11 @@
 #include "ProjectileParticleDataAsset.generated.h"
 
 /**
- * 
+ * primary asset (like UProjectileSoundDataAsset), registered in the asset manager settings,
+ * loaded with its weapon by FProjectileAssetStreamer
  */
 UCLASS()
-class TPS_STUDY_API UProjectileParticleDataAsset : public UDataAsset
+class TPS_STUDY_API UProjectileParticleDataAsset : public UPrimaryDataAsset
 {
 	GENERATED_BODY()
 
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "ProjectileEnum.generated.h"
+
+/** how ATPS_ProjectileSimulation sweeps a projectile class */
+UENUM(BlueprintType)
+enum class EProjectileCollisionMode : uint8
+{
+	/** sweep on the game thread, hit in the same frame */
+	Sync,
+	/** batched async sweep, hit consumed next frame */
+	Async
+};
+
+/** how far from every local view a projectile is, set each frame by ATPS_ProjectileSimulation */
+UENUM(BlueprintType)
+enum class EProjectileSignificance : uint8
+{
+	/** swept and moved every frame, trail shown */
+	Near,
+	/** swept and moved every other frame, trail shown */
+	Mid,
+	/** swept and moved every few frames, trail hidden */
+	Far,
+	/** behind every local view and not near, same as Far */
+	Hidden,
+	Max UMETA(Hidden)
+};
+
+/**
+ * 
+ */
+UCLASS()
+class TPS_STUDY_API UProjectileEnum : public UObject
+{
+	GENERATED_BODY()
+	
+};
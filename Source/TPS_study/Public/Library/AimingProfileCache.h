@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Struct/AimingStruct.h"
+
+class UDataTable;
+
+/** every row of one aiming table, indexed like UDataTable::GetRowNames */
+struct FAimingProfileTable
+{
+	TArray<FName> AimingNames;
+	TArray<FAimingStat> AimStats;
+
+	FORCEINLINE int32 Num() const { return AimStats.Num(); }
+};
+
+/**
+ * process wide flyweight of the aiming tables
+ * a table is read the first time it is asked for, after that every
+ * UAimingComponent using it share the same FAimingProfileTable
+ * and only keep its own default stat (camera and movement of its character)
+ * game thread only
+ */
+struct TPS_STUDY_API FAimingProfileCache
+{
+	/** return the built table, build it on first use, nullptr if AimingTable is nullptr */
+	static const FAimingProfileTable* GetAimingProfiles(const UDataTable* AimingTable);
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * fire rate enforced from timestamps instead of a timer per shot
+ * a round due at time T and fired at Now is given the offset Now - T,
+ * so it is spawned where it would be if it had been fired on time
+ * the number of rounds fired over a duration does not depend on the frame rate
+ */
+struct TPS_STUDY_API FFireScheduler
+{
+	/** a hitch longer than this many rounds drop the rest instead of firing them all at once */
+	static constexpr int32 MaxRoundsPerFrame = 16;
+
+	FORCEINLINE bool IsReady(const float Now) const { return Now >= NextFireTime; }
+
+	/** fire one round now (trigger press), the next one is due after FireInterval */
+	void FireNow(const float Now, const float FireInterval);
+
+	/**
+	 * return how many rounds are due at Now (max MaxRoundsPerFrame)
+	 * and write how late each one is (second) in OutTimeOffsets, oldest first
+	 */
+	int32 ConsumeDueRounds(const float Now, const float FireInterval, float* OutTimeOffsets);
+
+	void Reset();
+
+private:
+
+	/** world time the next round is allowed */
+	float NextFireTime = 0.0f;
+};
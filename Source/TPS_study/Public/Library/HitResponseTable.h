@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class UParticleSystem;
+class USoundBase;
+class UProjectileParticleDataAsset;
+class UProjectileSoundDataAsset;
+
+/** index in FProjectileParticle::HitParticle */
+enum class EHitResponse : uint8
+{
+	World,
+	Character,
+	Water,
+	NoHit,
+	Max
+};
+
+/** object type of the hit component, as a row of FHitResponseTable */
+enum class EHitChannel : uint8
+{
+	World,
+	Player,
+	Enemy,
+	Max
+};
+
+/** weak, a table never keep an asset loaded, its weapon bundle does (FProjectileAssetStreamer) */
+struct FHitResponse
+{
+	TWeakObjectPtr<UParticleSystem> Particle;
+	TWeakObjectPtr<USoundBase> Sound;
+};
+
+/**
+ * hit particle and sound of one particle/sound data asset pair,
+ * resolved for every hit channel and physical surface when the table is built
+ * a hit is one array read, no search and no array bound to check
+ */
+struct TPS_STUDY_API FHitResponseTable
+{
+	FHitResponse Responses[(int32)EHitChannel::Max][SurfaceType_Max];
+
+	/** projectile retired without hitting anything */
+	FHitResponse NoHitResponse;
+
+	/** physical surface is only known if the query was made with bReturnPhysicalMaterial */
+	const FHitResponse& Resolve(const FHitResult& Hit) const;
+
+	static EHitChannel GetHitChannel(const ECollisionChannel ObjectType);
+
+	/** which HitParticle a hit on this channel and surface play */
+	static EHitResponse GetHitResponse(const EHitChannel HitChannel, const EPhysicalSurface SurfaceType);
+};
+
+/**
+ * one FHitResponseTable per data asset pair, shared by every projectile using it
+ * a table is never moved, and freed only once evicted and no longer held (FProjectileSpec, projectile in flight)
+ */
+struct TPS_STUDY_API FHitResponseCache
+{
+	/** build the table on first use, never nullptr (a nullptr asset give empty response) */
+	static TSharedPtr<const FHitResponseTable> GetHitResponses(const UProjectileParticleDataAsset* ParticleObject, const UProjectileSoundDataAsset* SoundObject);
+
+	/** forget the table of this pair when its bundle is released, the next GetHitResponses build a new one */
+	static void EvictHitResponses(const UProjectileParticleDataAsset* ParticleObject, const UProjectileSoundDataAsset* SoundObject);
+
+	static void BuildHitResponseTable(const UProjectileParticleDataAsset* ParticleObject, const UProjectileSoundDataAsset* SoundObject, FHitResponseTable& OutTable);
+};
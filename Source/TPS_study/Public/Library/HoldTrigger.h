@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * hold time of a charge trigger computed from the press timestamp
+ * instead of counted by a repeating timer, so it is exact at any frame rate
+ */
+struct TPS_STUDY_API FHoldTrigger
+{
+	FORCEINLINE bool IsHolding() const { return bIsHolding; }
+
+	void Press(const float Now);
+
+	/** return the hold time, 0 if the trigger was not held */
+	float Release(const float Now);
+
+	/** second the trigger has been held at Now, 0 if not held */
+	float GetHoldTime(const float Now) const;
+
+	/** hold time / MaxHoldTime, 0 to 1, 1 if MaxHoldTime is 0 */
+	float GetChargeFraction(const float Now, const float MaxHoldTime) const;
+
+	void Reset();
+
+private:
+
+	bool bIsHolding = false;
+
+	/** world time the trigger was pressed */
+	float HoldStartTime = 0.0f;
+};
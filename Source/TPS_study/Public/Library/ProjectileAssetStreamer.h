@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FOutputDevice;
+class USoundWave;
+struct FProjectileSpec;
+
+/**
+ * stream the particle and sound data asset of a weapon (its bundle) in the background
+ * a weapon is "owned" by every shooter that can switch to it, and "equipped" by the one holding it:
+ * the bundle is loaded when the weapon is equipped and kept while someone own it,
+ * it is released (left to the garbage collector) when the last owner drop it,
+ * with the hit response, FX pool and fire voice that held its asset (OnAssetsReleased)
+ * a round fired before the bundle arrived wait for it (LoadSynchronous) instead of firing without FX
+ * game thread only
+ */
+struct TPS_STUDY_API FProjectileAssetStreamer
+{
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnAssetsReleased, const TSet<UObject*>& /* ReleasedObjects */);
+
+	/**
+	 * broadcast by the last RemoveOwner of a bundle with every particle, cue and wave of it that no other bundle hold,
+	 * a pool or voice still referencing one should drop it so it can be garbage collected
+	 */
+	static FOnAssetsReleased OnAssetsReleased;
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnAssetsLoaded, const FProjectileSpec& /* LoadedSpec */);
+
+	/** broadcast when the asset requested by RequestAsyncLoad arrive and LoadedSpec is resolved */
+	static FOnAssetsLoaded OnAssetsLoaded;
+
+	/** start streaming the asset of MySpec, the spec is resolved when they arrive, MySpec must be owned (AddOwner) */
+	static void RequestAsyncLoad(const FProjectileSpec& MySpec);
+
+	/** block until the bundle handle of MySpec is loaded and resolve it, nothing to load if it already is, MySpec must be owned */
+	static void LoadSynchronous(const FProjectileSpec& MySpec);
+
+	static void AddOwner(const FProjectileSpec& MySpec);
+
+	/** the last owner release the bundle, MySpec is cleared (silent, no FX) until it is loaded again */
+	static void RemoveOwner(const FProjectileSpec& MySpec);
+
+	/** every wave the loaded sound asset of MySpec can play, cue are walked */
+	static void GetSoundWaves(const FProjectileSpec& MySpec, TArray<USoundWave*>& OutSoundWaves);
+
+	/** particle and sound memory held by the bundle handle of MySpec (estimated total), 0 if not loaded */
+	static SIZE_T GetResidentBytes(const FProjectileSpec& MySpec);
+
+	/** one line per tracked bundle: owner count, handle loaded, loading or not requested, resident byte, and the total */
+	static void DumpResidentAssets(FOutputDevice& Ar);
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** raw view on the projectile arrays integrated by FProjectileIntegrator */
+struct FProjectileIntegrationStream
+{
+	float* PositionX;
+	float* PositionY;
+	float* PositionZ;
+	const float* VelocityX;
+	const float* VelocityY;
+	float* VelocityZ;
+	const float* GravityZ;
+	float* LifeTime;
+	int32 Num;
+};
+
+/**
+ * ballistic integration of projectile (gravity along Z only)
+ *   position += velocity * dt (+ gravity * dt^2 / 2 on Z)
+ *   velocity.Z += gravity * dt
+ *   lifetime -= dt
+ * the two path do exactly the same float operations in the same order, no fused multiply-add,
+ * so both give bit identical result (TPS_study.Projectile.Integrator)
+ */
+struct TPS_STUDY_API FProjectileIntegrator
+{
+	/** plain float reference path, one operation per statement and no contraction */
+	static void IntegrateScalar(const FProjectileIntegrationStream& Stream, const float DeltaSeconds);
+
+	/** 4 projectiles per instruction with VectorRegister, the remainder one per register with the same operations */
+	static void IntegrateVector(const FProjectileIntegrationStream& Stream, const float DeltaSeconds);
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * built tables shared by every component reading the same source table, keyed by weak pointer
+ * (FWeaponSpecCache, FAimingProfileCache)
+ * a built table is never moved or freed: a stale one (its source edited in the editor) is rebuilt
+ * in a new one and the old one is retired, a component can still point into it until its next BeginPlay
+ * game thread only
+ */
+template<typename KeyType, typename BuiltType>
+class TSharedTableCache
+{
+public:
+
+	/** the built table of Key, nullptr if there is none yet or it is stale */
+	const BuiltType* Find(const KeyType& Key) const
+	{
+		const FCachedTable* cachedTable = CachedTables.Find(Key);
+		return (cachedTable && !cachedTable->bIsStale) ? cachedTable->BuiltTable.Get() : nullptr;
+	}
+
+	/** a new empty table to build for Key, bOutIsNewKey is true the first time Key is added (not when a stale one is replaced) */
+	BuiltType& Add(const KeyType& Key, bool& bOutIsNewKey)
+	{
+		FCachedTable* cachedTable = CachedTables.Find(Key);
+		bOutIsNewKey = cachedTable == nullptr;
+
+		if (bOutIsNewKey)
+		{
+			cachedTable = &CachedTables.Add(Key);
+		}
+		else
+		{
+			RetiredTables.Add(MoveTemp(cachedTable->BuiltTable));
+		}
+
+		cachedTable->BuiltTable = MakeUnique<BuiltType>();
+		cachedTable->bIsStale = false;
+
+		return *cachedTable->BuiltTable;
+	}
+
+	/** every table whose key match is rebuilt by the next Add */
+	template<typename PredicateType>
+	void MarkStale(PredicateType Predicate)
+	{
+		for (TPair<KeyType, FCachedTable>& cachedTable : CachedTables)
+		{
+			if (Predicate(cachedTable.Key)) cachedTable.Value.bIsStale = true;
+		}
+	}
+
+private:
+
+	struct FCachedTable
+	{
+		TUniquePtr<BuiltType> BuiltTable;
+		bool bIsStale;
+	};
+
+	TMap<KeyType, FCachedTable> CachedTables;
+
+	/** replaced table */
+	TArray<TUniquePtr<BuiltType>> RetiredTables;
+};
@@ -2,8 +2,12 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataTable.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "UObject/ConstructorHelpers.h"
 #include "TPSFunctionLibrary.generated.h"
 
 class UAnimMontage;
@@ -28,6 +32,29 @@ public:
 
 	static float  StandardLinearInterpolation(const float X, const float X1, const float X2, const float Y1, const float Y2);
 
+	/**
+	 * return the one manager actor of this class in the world,
+	 * spawn it (transient) the first time it is asked for
+	 * cache the result, this iterate the world actor list
+	 */
+	template<class MyManager>
+	static MyManager* GetWorldManager(const UObject* WorldContextObject)
+	{
+		UWorld* world = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+		if (world == nullptr) return nullptr;
+
+		for (TActorIterator<MyManager> it(world); it; ++it)
+		{
+			if (!it->IsPendingKill()) return *it;
+		}
+
+		FActorSpawnParameters spawnParams;
+		spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		spawnParams.ObjectFlags |= RF_Transient;
+
+		return world->SpawnActor<MyManager>(MyManager::StaticClass(), FTransform::Identity, spawnParams);
+	}
+
 	/*template<class MyObject>
 	static MyObject* GetThisObject(const TCHAR * ObjectToFind, const bool bShouldCheck = true)
 	{
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Enum/AmmoAndEnergyEnum.h"
+#include "Enum/RangedWeaponEnum.h"
+
+class UCurveTable;
+class UDataTable;
+class UProjectileParticleDataAsset;
+class UProjectileSoundDataAsset;
+class USoundBase;
+struct FHitResponseTable;
+struct FWeaponMode;
+
+/**
+ * FProjectile resolved once: no TArray, no default to check on fire
+ */
+struct FProjectileSpec
+{
+	float Speed;
+	float GravityScale;
+	float ParticleScale;
+
+	/** FProjectileData::MaxLifeTime and MaxRange, 0 = no limit of its own */
+	float MaxLifeTime;
+	float MaxRange;
+
+	/** Speed >= FProjectileData::HitscanSpeed, see ATPS_ProjectileSimulation::AddHitscanProjectile */
+	bool bIsHitscan;
+
+	/** never nullptr, ATPS_Projectile if the row has none */
+	UClass* ProjectileClass;
+
+	/** FProjectile soft references, streamed by FProjectileAssetStreamer */
+	TSoftObjectPtr<UProjectileParticleDataAsset> ParticleAsset;
+	TSoftObjectPtr<UProjectileSoundDataAsset> SoundAsset;
+
+	/**
+	 * every field below come from the two asset, they are empty while the asset are not loaded,
+	 * see FWeaponSpecCache::ResolveProjectileAssets and ClearProjectileAssets
+	 */
+	bool bAssetsResolved;
+
+	UProjectileParticleDataAsset* ParticleObject;
+	UProjectileSoundDataAsset* SoundObject;
+
+	/** from SoundObject, fire audio is played by the weapon once per round, not per projectile */
+	USoundBase* MuzzleSound;
+	USoundBase* FireLoopSound;
+	USoundBase* FireTailSound;
+	int32 MaxMuzzleVoice;
+
+	/** hit particle and sound of the two asset above, by hit channel and surface, never nullptr */
+	TSharedPtr<const FHitResponseTable> HitResponses;
+
+	/** the particle asset has a trail, so the projectile need a pooled actor to be seen */
+	bool bHasTrail;
+};
+
+/**
+ * one row of the weapon table, flattened
+ * read only and shared by every shooter using the same table
+ */
+struct FWeaponSpec
+{
+	/** muzzle past this are ignored (with a warning when the cache is built) */
+	static constexpr int32 MaxMuzzleCount = 8;
+
+	/** sample baked from the RPM table row, alpha 0 to 1 */
+	static constexpr int32 SpinSampleCount = 32;
+
+	FName MuzzleNames[MaxMuzzleCount];
+	int32 MuzzleCount;
+
+	/** FWeapon::FireRateAndOther[0] */
+	float FireRate;
+
+	/** FWeapon::FireRateAndOther[1], the fire rate if the row has none */
+	float MaxHoldTime;
+
+	ETriggerMechanism Trigger;
+	EWeaponCost WeaponCost;
+	EAmmoType AmmoType;
+	EEnergyType EnergyType;
+	float EnergyUsePerShot;
+
+	/** the RPM table has a row with the weapon name */
+	bool bHasSpinUp;
+
+	/** FWeapon::FireRateAndOther[5] and [6] */
+	float SpinUpTime;
+	float SpinDownTime;
+
+	/** RPM table row (round per second) at alpha i / (SpinSampleCount - 1) */
+	float SpinRoundsPerSecond[SpinSampleCount];
+
+	FProjectileSpec Projectile;
+
+	/** second between round at this spin alpha, FireRate if the weapon has no spin up */
+	FORCEINLINE float GetFireInterval(const float SpinAlpha) const
+	{
+		if (!bHasSpinUp) return FireRate;
+
+		const float roundsPerSecond = GetRoundsPerSecond(SpinAlpha);
+		return (roundsPerSecond > KINDA_SMALL_NUMBER) ? 1.0f / roundsPerSecond : FireRate;
+	}
+
+	/** linear between the two nearest baked sample, no curve evaluation */
+	FORCEINLINE float GetRoundsPerSecond(const float SpinAlpha) const
+	{
+		if (!bHasSpinUp) return (FireRate > KINDA_SMALL_NUMBER) ? 1.0f / FireRate : 0.0f;
+
+		const float sample = FMath::Clamp(SpinAlpha, 0.0f, 1.0f) * (SpinSampleCount - 1);
+		const int32 index = FMath::Min(FMath::FloorToInt(sample), SpinSampleCount - 2);
+
+		return FMath::Lerp(SpinRoundsPerSecond[index], SpinRoundsPerSecond[index + 1], sample - index);
+	}
+};
+
+/** every row of one weapon table, indexed like UDataTable::GetRowNames */
+struct FWeaponSpecTable
+{
+	TArray<FName> WeaponNames;
+	TArray<FWeaponSpec> WeaponSpecs;
+
+	FORCEINLINE int32 Num() const { return WeaponSpecs.Num(); }
+};
+
+/**
+ * process wide flyweight of the weapon tables
+ * a table is read the first time it is asked for, after that every
+ * URangedWeaponComponent using it share the same FWeaponSpecTable
+ * and switching weapon is a pointer change instead of FindRow + FWeaponMode copy
+ * game thread only
+ */
+struct TPS_STUDY_API FWeaponSpecCache
+{
+	/**
+	 * return the built table, build it on first use, nullptr if WeaponTable is nullptr
+	 * RPMTable is optional, a weapon with a row of the same name in it get a baked spin up
+	 */
+	static const FWeaponSpecTable* GetWeaponSpecs(const UDataTable* WeaponTable, const UCurveTable* RPMTable = nullptr);
+
+	static void BuildWeaponSpec(const FWeaponMode& WeaponMode, FWeaponSpec& OutSpec);
+
+	/**
+	 * fill the asset fields of OutSpec from its loaded ParticleAsset and SoundAsset
+	 * only done by FProjectileAssetStreamer, once the bundle handle holding them is loaded
+	 */
+	static void ResolveProjectileAssets(FProjectileSpec& OutSpec);
+
+	/** empty the asset fields of OutSpec (silent, no FX), before its asset are released */
+	static void ClearProjectileAssets(FProjectileSpec& OutSpec);
+
+	/** sample the RPM table row RowName into OutSpec, false if there is no such row */
+	static bool BakeSpinUp(const UCurveTable* RPMTable, const FName RowName, FWeaponSpec& OutSpec);
+};
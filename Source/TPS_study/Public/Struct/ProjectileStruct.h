@@ -4,11 +4,10 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
-#include "UObject/ConstructorHelpers.h"
 #include "Particles/ParticleSystem.h"
-#include "Custom/ShouldCheckFile.h"
 #include "ProjectileStruct.generated.h"
 
+class ATPS_Projectile;
 class USoundBase;
 class UProjectileParticleDataAsset;
 class UProjectileSoundDataAsset;
@@ -26,6 +25,21 @@ struct FProjectileData
 	 */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	TArray<float> SpeedxGravityxScale = {8000.0f};
+
+	/** second before a projectile that hit nothing is retired, 0 = MaxLifeTime of the projectile simulation */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	float MaxLifeTime = 0.0f;
+
+	/** distance (cm) at muzzle speed before a projectile that hit nothing is retired, 0 = no limit */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	float MaxRange = 0.0f;
+
+	/**
+	 * projectile at least this fast are resolved at fire time (swept along their ballistic path),
+	 * their impact is played at arrival time and only a tracer is seen, 0 = always simulated
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	float HitscanSpeed = 0.0f;
 };
 
 USTRUCT(BlueprintType)
@@ -34,34 +48,26 @@ struct FProjectileSound
 	GENERATED_BODY();
 
 	UPROPERTY(BlueprintReadOnly, EditAnywhere)
-	USoundBase* MuzzleSound;
+	USoundBase* MuzzleSound = nullptr;
 
 	/**
 	 * 0 = hit sound
-	 * 1 = trail sound
+	 * 1 = trail sound, also the tail played when a looping automatic fire stop
 	 */
 	UPROPERTY(BlueprintReadOnly, EditAnywhere)
 	TArray<USoundBase*> HitAndTrailSound = { nullptr };
 
-	FProjectileSound()
-	{
-		if (SHOULDNOTCHECKFILEFORSTRUCT) return;
-
-		if (MuzzleSound == nullptr)
-		{
-			static ConstructorHelpers::FObjectFinder<USoundBase> inSound1(TEXT("SoundCue'/Game/Sounds/Weapon_AssaultRifle/Stereo/AssaultRifle_Shot_Stereo_Cue.AssaultRifle_Shot_Stereo_Cue'"));
-			if (SHOULDCHECKFILE) check(inSound1.Succeeded());
-			MuzzleSound = inSound1.Object;
-		}
-
-		if (HitAndTrailSound[0] == nullptr)
-		{
-			static ConstructorHelpers::FObjectFinder<USoundBase> inSound2(TEXT("SoundCue'/Game/Sounds/Weapon_AssaultRifle/Stereo/AssaultRifle_End_Stereo_Cue.AssaultRifle_End_Stereo_Cue'"));
-			if (SHOULDCHECKFILE) check(inSound2.Succeeded());
-			HitAndTrailSound[0] = inSound2.Object;
-		}
-
-	}
+	/**
+	 * looping sound of an automatic weapon, played from the first round until the trigger is released
+	 * MuzzleSound is not played per round then, empty = MuzzleSound every round
+	 */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere)
+	USoundBase* FireLoopSound = nullptr;
+
+	/** MuzzleSound of one shooter playing at the same time, the oldest is cut for a new round */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere)
+	int32 MaxMuzzleVoice = 4;
+
 };
 
 USTRUCT(BlueprintType)
@@ -78,8 +84,9 @@ struct FProjectileParticle
 	/**
 	 * 0 = HitWorld
 	 * 1 = HitCharacter
-	 * 2 = HiWater
+	 * 2 = HitWater
 	 * 3 = NoHit
+	 * missing HitCharacter/HitWater play HitWorld, see FHitResponseTable
 	 */
 	UPROPERTY(BlueprintReadOnly, EditAnywhere)
 	TArray<UParticleSystem*> HitParticle;
@@ -87,45 +94,6 @@ struct FProjectileParticle
 	UPROPERTY(BlueprintReadOnly, EditAnywhere)
 	TArray<UParticleSystem*> OtherParticle;
 
-	FProjectileParticle()
-	{
-		if (SHOULDNOTCHECKFILEFORSTRUCT) return;
-
-		if (MuzzleParticle[0] == nullptr)
-		{
-			static ConstructorHelpers::FObjectFinder<UParticleSystem> inParticle(TEXT("ParticleSystem'/Game/ParagonWraith/FX/Particles/Abilities/Primary/FX/P_Wraith_Primary_MuzzleFlash.P_Wraith_Primary_MuzzleFlash'"));
-			if (SHOULDCHECKFILE) check(inParticle.Succeeded());
-			MuzzleParticle[0] = inParticle.Object;
-		}
-
-		if (TrailParticle[0] == nullptr)
-		{
-			static ConstructorHelpers::FObjectFinder<UParticleSystem> inParticle2(TEXT("ParticleSystem'/Game/ParagonWraith/FX/Particles/Abilities/Primary/FX/P_Wraith_Primary_Trail.P_Wraith_Primary_Trail'"));
-			if (SHOULDCHECKFILE) check(inParticle2.Succeeded());
-			TrailParticle[0] = inParticle2.Object;
-		}
-
-		HitParticle.SetNum(1);
-
-		if (HitParticle[0] == nullptr)
-		{
-			static ConstructorHelpers::FObjectFinder<UParticleSystem> inParticle3(TEXT("ParticleSystem'/Game/ParagonWraith/FX/Particles/Abilities/Primary/FX/P_Wraith_Primary_HitWorld.P_Wraith_Primary_HitWorld'"));
-			if (SHOULDCHECKFILE) check(inParticle3.Succeeded());
-			HitParticle[0] = inParticle3.Object;
-
-			static ConstructorHelpers::FObjectFinder<UParticleSystem> inParticle4(TEXT("ParticleSystem'/Game/ParagonWraith/FX/Particles/Abilities/Primary/FX/P_Wraith_Primary_HitCharacter.P_Wraith_Primary_HitCharacter'"));
-			if (SHOULDCHECKFILE) check(inParticle4.Succeeded());
-			HitParticle.Add(inParticle4.Object);
-
-			static ConstructorHelpers::FObjectFinder<UParticleSystem> inParticle5(TEXT("ParticleSystem'/Game/ParagonWraith/FX/Particles/Abilities/Primary/FX/P_Wraith_Primary_HitWorld_Water.P_Wraith_Primary_HitWorld_Water'"));
-			if (SHOULDCHECKFILE) check(inParticle5.Succeeded());
-			HitParticle.Add(inParticle5.Object);
-
-			static ConstructorHelpers::FObjectFinder<UParticleSystem> inParticle6(TEXT("ParticleSystem'/Game/ParagonWraith/FX/Particles/Abilities/Primary/FX/P_Wraith_Primary_NoHit.P_Wraith_Primary_NoHit'"));
-			if (SHOULDCHECKFILE) check(inParticle6.Succeeded());
-			HitParticle.Add(inParticle6.Object);
-		}
-	}
 };
 
 USTRUCT(BlueprintType)
@@ -136,11 +104,16 @@ struct FProjectile
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	FProjectileData ProjectileData;
 
+	/** class handed out by the projectile pool, ATPS_Projectile if empty */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TSubclassOf<ATPS_Projectile> ProjectileClass;
+
+	/** soft, so the weapon table does not load every FX, streamed per weapon by FProjectileAssetStreamer */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
-	UProjectileParticleDataAsset* ProjectileParticle;
+	TSoftObjectPtr<UProjectileParticleDataAsset> ProjectileParticle;
 
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
-	UProjectileSoundDataAsset* ProjectileSound;
+	TSoftObjectPtr<UProjectileSoundDataAsset> ProjectileSound;
 };
 
 UCLASS()
@@ -21,6 +21,8 @@ struct FWeapon
 	 * 2 = reload time,
 	 * 3 = equip time,
 	 * 4 = unequip time
+	 * 5 = spin up time (0 to 1 in the RPM table)
+	 * 6 = spin down time
 	 * all of that are in second
 	 */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)